@@ -7,17 +7,11 @@
 #include "ReefGameInstance.generated.h"
 
 class Terrain;
-class AFixedBeing;
 /**
- *
+ * The fixed beings of a world are tracked by UFixedBeingStreamingSubsystem
  */
 UCLASS()
 class REEFGAME_API UReefGameInstance : public UGameInstance
 {
 	GENERATED_BODY()
-
-public:
-
-	UPROPERTY()
-	TArray<AFixedBeing*> FixedBeings;
 };
@@ -8,6 +8,7 @@
 #include "Kismet/KismetMathLibrary.h"
 #include "NiagaraFunctionLibrary.h"
 #include "HighlightComponent.h"
+#include "Terrain/TerrainQuerySubsystem.h"
 
 // Sets default values
 ABaseFish::ABaseFish()
@@ -461,6 +462,24 @@ bool ABaseFish::IsObstacle()
 		(GetActorForwardVector() - GetActorRightVector() * 0.5f).GetSafeNormal()
 	};
 
+	// The terrain is by far the largest obstacle, check it against the baked heightfield and leave physics only the rest
+	const UTerrainQuerySubsystem* TerrainQuery = GetWorld()->GetSubsystem<UTerrainQuerySubsystem>();
+	if(TerrainQuery && TerrainQuery->IsOk())
+	{
+		if(AActor* TerrainActor = TerrainQuery->GetTerrainActor())
+		{
+			TraceParams.AddIgnoredActor(TerrainActor);
+		}
+		FTerrainRayHit TerrainHit;
+		for(const FVector& Direction : Directions)
+		{
+			if(TerrainQuery->RaycastTerrain(StartLocation, StartLocation + (Direction * TraceDistance), TerrainHit))
+			{
+				return true;
+			}
+		}
+	}
+
 	for(const FVector& Direction : Directions)
 	{
 		FVector EndLocation = StartLocation + (Direction * TraceDistance);
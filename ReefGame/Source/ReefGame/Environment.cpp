@@ -1,10 +1,8 @@
 #include "Environment.h"
-#include "Editor.h"
-#include "Async/Async.h"
-#include "Flora/FixedBeingsManagerEditorSubsystem.h"
-#include "Terrain/Terrain.h"
-
-class UFixedBeingsManagerEditorSubsystem;
+#include "EnvironmentEditor.h"
+#include "Flora/FixedBeingsSnapshot.h"
+#include "Terrain/TerrainQuerySubsystem.h"
+#include "Flora/FixedBeingStreamingSubsystem.h"
 
 AEnvironment::AEnvironment()
 {
@@ -14,168 +12,103 @@ AEnvironment::AEnvironment()
 	RootSceneComponent = CreateDefaultSubobject<USceneComponent>(TEXT("RootSceneComponent"));
 	RootComponent = RootSceneComponent;
 
+	FixedBeingsSnapshot = CreateDefaultSubobject<UFixedBeingsSnapshot>(TEXT("FixedBeingsSnapshot"));
+
 
 	UE_LOG(LogTemp, Warning, TEXT("AEnvironment::AEnvironment"));
 }
 
 // LIFECYCLE
 
-void AEnvironment::OnConstruction(const FTransform& Transform)
+void AEnvironment::BeginPlay()
 {
-	Super::OnConstruction(Transform);
-	if(auto const FBManager = GEditor->GetEditorSubsystem<UFixedBeingsManagerEditorSubsystem>())
+	Super::BeginPlay();
+
+	// the terrain is attached to the environment with no offset
+	if(auto const TerrainQuery = GetWorld()->GetSubsystem<UTerrainQuerySubsystem>())
 	{
-		FBManager->CheckChildren(this);
+		TerrainQuery->SetHeightfield(BakedHeightfield, GetActorTransform(), TerrainActor);
 	}
-	if(auto const TManager = GEditor->GetEditorSubsystem<UTerrainManagerEditorSubsystem>())
+	if(auto const Streaming = GetWorld()->GetSubsystem<UFixedBeingStreamingSubsystem>())
 	{
-		if(!TManager->IsOk())
-		{
-			TManager->SetMaterial(TerrainMaterial);
-			TManager->SetCliffCurve(CliffCurve);
-		}
-		TManager->CheckChildren(this);
+		Streaming->Configure(FixedBeingsCellSize, FixedBeingsActivationDistance, FixedBeingsDeactivationMargin);
 	}
 }
 
-
-// TERRAIN STUFF
-
-FTerrainParameters AEnvironment::GetTerrainParams() const
-{
-	return FTerrainParameters(
-		{
-			Width,
-			Height,
-			Density,
-			SandBankHeight,
-			SandRoughness,
-			PerlinOffset,
-			CliffScale,
-			CliffIntensity,
-			CliffRoughness,
-			CliffRoughnessIntensity,
-			CliffModifierSeed,
-			CliffModifierDensity,
-			CliffModifierIntensity
-		}
-	);
-}
-
-// REGENERATION STUFF
-
 #if WITH_EDITOR
 
-void AEnvironment::RegenerateTerrain()
-{
+// EDITOR STUFF, generating and baking happen in the editor module
 
-	auto const TerrainManager = GEditor->GetEditorSubsystem<UTerrainManagerEditorSubsystem>();
-	if(!TerrainManager)
+void AEnvironment::OnConstruction(const FTransform& Transform)
+{
+	Super::OnConstruction(Transform);
+	if(IEnvironmentEditor* const Editor = IEnvironmentEditor::Get())
 	{
-		UE_LOG(LogTemp, Error, TEXT("TerrainManager is not set"));
-		return;
+		Editor->OnConstruction(*this);
 	}
-	TerrainManager->bDirty = true;
-	TerrainManager->CheckChildren(this);
-	AsyncTask(ENamedThreads::GameThread, [this]
-	{
-		RegenerateEnvironmentInternal();
-	});
 }
 
-
-void AEnvironment::RegenerateEnvironmentInternal()
+/**
+ * Hand an action of the environment over to the editor module.
+ *
+ * @return The editor module, null if it is not loaded
+ */
+static IEnvironmentEditor* GetEnvironmentEditor()
 {
-	// Terrain Generation
-	auto const TerrainManager = GEditor->GetEditorSubsystem<UTerrainManagerEditorSubsystem>();
-	if(!TerrainManager)
-	{
-		UE_LOG(LogTemp, Error, TEXT("TerrainManager is not set"));
-		return;
-	}
-	if(!TerrainMaterial)
-	{
-		UE_LOG(LogTemp, Error, TEXT("TerrainMaterial is not set"));
-		return;
-	}
-	if(!CliffCurve)
+	IEnvironmentEditor* const Editor = IEnvironmentEditor::Get();
+	if(!Editor)
 	{
-		UE_LOG(LogTemp, Error, TEXT("CliffCurve is not set"));
-		return;
+		UE_LOG(LogTemp, Error, TEXT("The ReefGameEditor module is not loaded"));
 	}
+	return Editor;
+}
 
-	TerrainActor = TerrainManager->GetTerrain(GetTerrainParams(), TerrainMaterial, CliffCurve);
-	if(!TerrainActor)
+void AEnvironment::RegenerateTerrain()
+{
+	if(IEnvironmentEditor* const Editor = GetEnvironmentEditor())
 	{
-		UE_LOG(LogTemp, Error, TEXT("TerrainActor Failed to generate"));
-		return;
+		Editor->RegenerateTerrain(*this);
 	}
-	TerrainActor->AttachToActor(this, FAttachmentTransformRules::KeepRelativeTransform);
-
-
-	// Log Bounding Box
-	UE_LOG(LogTemp, Warning, TEXT("Terrain Bounding Box: %s"), *TerrainManager->GetBoundingBox2D().ToString());
-
-	RegenerateFixedBeings();
 }
 
-// FIXED BEINGS STUFF
-
 void AEnvironment::RegenerateFixedBeings()
 {
-
-	auto const TerrainManager = GEditor->GetEditorSubsystem<UTerrainManagerEditorSubsystem>();
-	if(!TerrainManager)
+	if(IEnvironmentEditor* const Editor = GetEnvironmentEditor())
 	{
-		UE_LOG(LogTemp, Error, TEXT("TerrainManager is not set"));
-		return;
-	}
-	UE_LOG(LogTemp, Log, TEXT("RegenerateFixedBeings"));
-	if(!TerrainActor || !TerrainManager->IsOk())
-	{
-		RegenerateTerrain();
-		return;
+		Editor->RegenerateFixedBeings(*this);
 	}
+}
 
-	AsyncTask(ENamedThreads::GameThread, [this]()
+void AEnvironment::RegenerateFixedBeingsInRegion()
+{
+	if(IEnvironmentEditor* const Editor = GetEnvironmentEditor())
 	{
-		RegenerateFixedBeingsInternal();
-	});
+		Editor->RegenerateFixedBeingsInRegion(*this);
+	}
 }
 
 void AEnvironment::ClearFixedBeings()
 {
-	auto const FBManager = GEditor->GetEditorSubsystem<UFixedBeingsManagerEditorSubsystem>();
-	if(!FBManager)
+	if(IEnvironmentEditor* const Editor = GetEnvironmentEditor())
 	{
-		UE_LOG(LogTemp, Error, TEXT("FBManager is not set"));
-		return;
+		Editor->ClearFixedBeings(*this);
 	}
-	FBManager->ClearSpawned();
-	FBManager->CheckChildren(this);
 }
 
-
-void AEnvironment::RegenerateFixedBeingsInternal()
+void AEnvironment::BakeTerrain()
 {
-
-	auto const FBManager = GEditor->GetEditorSubsystem<UFixedBeingsManagerEditorSubsystem>();
-	if(!FBManager)
+	if(IEnvironmentEditor* const Editor = GetEnvironmentEditor())
 	{
-		UE_LOG(LogTemp, Error, TEXT("FBManager is not set"));
-		return;
+		Editor->BakeTerrain(*this);
 	}
-	if(!TerrainActor)
+}
+
+void AEnvironment::ExportPlacementRasters()
+{
+	if(IEnvironmentEditor* const Editor = GetEnvironmentEditor())
 	{
-		UE_LOG(LogTemp, Error, TEXT("TerrainActor is not set"));
-		return;
+		Editor->ExportPlacementRasters(*this);
 	}
-
-	FFixedBeingsParameters const Parameters{FixedBeingPlacingPrecision, FixedBeingPlacingPasses, ClusterRange};
-
-	FBManager->CheckChildren(this);
-	FBManager->RedistributeFixedBeings(Parameters, this, FixedBeingsClasses);
 }
 
-
 #endif
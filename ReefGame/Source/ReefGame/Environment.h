@@ -4,33 +4,42 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
-#include "Terrain/TerrainManagerEditorSubsystem.h"
+#include "Flora/FixedBeingPlacement.h"
 #include "Environment.generated.h"
 
 class ATerrain;
 class UProceduralMeshComponent;
-struct FSpawnedBeing;
+class UMaterialInterface;
+class UCurveVector;
 class AFixedBeing;
+class UTerrainHeightfield;
+class UFixedBeingsSnapshot;
 
 UCLASS()
 class REEFGAME_API AEnvironment : public AActor {
 	GENERATED_BODY()
 
-	void                RegenerateEnvironmentInternal();
-	void                RegenerateFixedBeingsInternal();
-	FTerrainParameters GetTerrainParams() const;
 public:
 	// Sets default values for this actor's properties
 	AEnvironment();
 
+	virtual void BeginPlay() override;
+
 	#if WITH_EDITOR
+	// Carried out by the editor module, see IEnvironmentEditor
 
 	UFUNCTION(BlueprintCallable, CallInEditor, Category = "Environment")
 	void RegenerateTerrain();
 	UFUNCTION(BlueprintCallable, CallInEditor, Category = "Environment")
 	void RegenerateFixedBeings();
 	UFUNCTION(BlueprintCallable, CallInEditor, Category = "Environment")
+	void RegenerateFixedBeingsInRegion();
+	UFUNCTION(BlueprintCallable, CallInEditor, Category = "Environment")
 	void ClearFixedBeings();
+	UFUNCTION(BlueprintCallable, CallInEditor, Category = "Environment")
+	void BakeTerrain();
+	UFUNCTION(BlueprintCallable, CallInEditor, Category = "Environment")
+	void ExportPlacementRasters();
 
 	virtual void OnConstruction(const FTransform& Transform) override;
 	#endif
@@ -68,6 +77,14 @@ public:
 	UPROPERTY(EditAnywhere, Category = "Environment")
 	float CliffModifierIntensity = 100;
 
+	// Vertices per unit of the terrain collision, kept coarser than Density to make traces against the terrain cheaper
+	UPROPERTY(EditAnywhere, Category = "Environment", meta = (ClampMin = "0.0001"))
+	float CollisionDensity = 0.001f;
+
+	// How far, in units, the rendered terrain may be from the full grid. Flat areas collapse into large triangles, 0 renders every vertex
+	UPROPERTY(EditAnywhere, Category = "Environment", meta = (ClampMin = "0.0"))
+	float MeshTolerance = 0.f;
+
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
 	USceneComponent* RootSceneComponent;
@@ -81,15 +98,42 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Environment")
 	UCurveVector* CliffCurve;
 
+	// Baked by BakeTerrain, used for terrain queries at runtime
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Environment")
+	UTerrainHeightfield* BakedHeightfield;
+
 	UPROPERTY(EditAnywhere, Category="Environment")
 	float FixedBeingPlacingPrecision = 10.f;
 	UPROPERTY(EditAnywhere, Category="Environment")
+	EFixedBeingPlacement FixedBeingPlacement = EFixedBeingPlacement::Passes;
+	UPROPERTY(EditAnywhere, Category="Environment")
 	int32 FixedBeingPlacingPasses = 100;
 
 	UPROPERTY(EditAnywhere, Category="Environment")
 	float ClusterRange = 1000.f;
 
+	// Place the fixed beings as instances of their class mesh instead of one actor each, beings marked bNeedsActor still get an actor
+	UPROPERTY(EditAnywhere, Category="Environment")
+	bool bInstanceFixedBeings = false;
+
 	UPROPERTY(EditAnywhere, Category="Environment")
 	TArray<TSubclassOf<AFixedBeing>> FixedBeingsClasses;
 
+	// Fixed beings are grouped into square cells of this size at runtime, and only the cells near a local player are active
+	UPROPERTY(EditAnywhere, Category="Streaming", meta = (ClampMin = "100.0"))
+	float FixedBeingsCellSize = 5000.f;
+	UPROPERTY(EditAnywhere, Category="Streaming", meta = (ClampMin = "0.0"))
+	float FixedBeingsActivationDistance = 20000.f;
+	// How much further than the activation distance a cell has to be before it is deactivated again
+	UPROPERTY(EditAnywhere, Category="Streaming", meta = (ClampMin = "0.0"))
+	float FixedBeingsDeactivationMargin = 2500.f;
+
+	// Relative to the environment, RegenerateFixedBeingsInRegion only re-places the beings in here
+	UPROPERTY(EditAnywhere, Category="Environment")
+	FBox2D FixedBeingsRegion = FBox2D(FVector2D::ZeroVector, FVector2D(5000.f));
+
+	// The placement of the fixed beings as one undo entry, regenerations do not record the beings themselves
+	UPROPERTY()
+	UFixedBeingsSnapshot* FixedBeingsSnapshot;
+
 };
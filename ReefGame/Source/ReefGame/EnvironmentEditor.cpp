@@ -0,0 +1,5 @@
+#include "EnvironmentEditor.h"
+
+#if WITH_EDITOR
+IEnvironmentEditor* IEnvironmentEditor::Instance = nullptr;
+#endif
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+class AEnvironment;
+class UFixedBeingsSnapshot;
+
+#if WITH_EDITOR
+/**
+ * What the editor-only code of an environment asks of the editor.
+ * The terrain and fixed beings managers live in the editor module, which depends on this one, so the editor module
+ * registers its implementation on startup instead of the environment reaching for the managers itself.
+ */
+class REEFGAME_API IEnvironmentEditor {
+public:
+	virtual ~IEnvironmentEditor() = default;
+
+	virtual void OnConstruction(AEnvironment& Environment) = 0;
+	virtual void RegenerateTerrain(AEnvironment& Environment) = 0;
+	virtual void RegenerateFixedBeings(AEnvironment& Environment) = 0;
+	virtual void RegenerateFixedBeingsInRegion(AEnvironment& Environment) = 0;
+	virtual void ClearFixedBeings(AEnvironment& Environment) = 0;
+	virtual void BakeTerrain(AEnvironment& Environment) = 0;
+	virtual void ExportPlacementRasters(AEnvironment& Environment) = 0;
+
+	/**
+	 * Put the placement of a snapshot back, called when the snapshot is undone or redone.
+	 *
+	 * @param Snapshot  The snapshot as it is after the undo.
+	 * @param Parent  The environment the snapshot belongs to.
+	 */
+	virtual void RestorePlacement(UFixedBeingsSnapshot const& Snapshot, AActor* Parent) = 0;
+
+	/**
+	 * @return The implementation of the editor module, null while it is not loaded
+	 */
+	static IEnvironmentEditor* Get() { return Instance; }
+
+	/**
+	 * @param NewInstance  The implementation to use from now on, null to unregister.
+	 */
+	static void Register(IEnvironmentEditor* NewInstance) { Instance = NewInstance; }
+
+private:
+	static IEnvironmentEditor* Instance;
+};
+#endif
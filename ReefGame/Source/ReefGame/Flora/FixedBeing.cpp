@@ -3,21 +3,13 @@
 
 #include "FixedBeing.h"
 
-#include "Selection.h"
+#include "FixedBeingStreamingSubsystem.h"
 
 // Sets default values
 AFixedBeing::AFixedBeing()
 {
-	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
-
-    #if WITH_EDITOR
-	// tick in editor
-	PrimaryActorTick.bStartWithTickEnabled = true;
-
-
-	USelection::SelectObjectEvent.AddUObject(this, &AFixedBeing::OnObjectSelected);
-	#endif
+	// Fixed beings do nothing over time, the cluster radius of the selected ones is drawn by UFixedBeingSelectionEditorSubsystem
+	PrimaryActorTick.bCanEverTick = false;
 }
 
 // Called when the game starts or when spawned
@@ -25,33 +17,69 @@ void AFixedBeing::BeginPlay()
 {
 	Super::BeginPlay();
 
+	if(auto const Streaming = GetWorld()->GetSubsystem<UFixedBeingStreamingSubsystem>())
+	{
+		Streaming->Register(this);
+	}
 }
 
-bool AFixedBeing::ShouldTickIfViewportsOnly() const
+void AFixedBeing::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	return bIsSelected;
+	if(auto const Streaming = GetWorld()->GetSubsystem<UFixedBeingStreamingSubsystem>())
+	{
+		Streaming->Unregister(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
-// Called every frame
-void AFixedBeing::Tick(float DeltaTime)
+#if WITH_EDITORONLY_DATA
+/**
+ * Move the placement of a being saved before it was kept in Placement over.
+ * The passes count from 1, so only a being saved with its placement in the old properties has a PlacementPass there.
+ */
+void AFixedBeing::PostLoad()
 {
-	Super::Tick(DeltaTime);
+	Super::PostLoad();
 
-	if(bIsSelected)
+	if(PlacementPass_DEPRECATED == 0.f)
 	{
-		// draw debug sprere
-		DrawDebugSphere(GetWorld(), GetActorLocation(), ClusterRadius, 100, FColor::FromHex( "AAAAAAAA" ), false, -1, 0, 1);
+		return;
 	}
+	Placement.ItemNumber = ItemNumber_DEPRECATED;
+	Placement.SkewedDepthAffinity = SkewedDepthAffinity_DEPRECATED;
+	Placement.SkewedFlatnessAffinity = SkewedFlatnessAffinity_DEPRECATED;
+	Placement.SelfClusterPositiveScore = SelfClusterPositiveScore_DEPRECATED;
+	Placement.SelfClusterNegativeScore = SelfClusterNegativeScore_DEPRECATED;
+	Placement.OthersClusterPositiveScore = OthersClusterPositiveScore_DEPRECATED;
+	Placement.OthersClusterNegativeScore = OthersClusterNegativeScore_DEPRECATED;
+	Placement.PlacementPass = PlacementPass_DEPRECATED;
+	Placement.NumberOfBeingsWhenPlaced = NumberOfBeingsWhenPlaced_DEPRECATED;
+	Placement.NumberOfBeingsNearby = NumberOfBeingsNearby_DEPRECATED;
+	Placement.NumberOfOtherBeingsNearby = NumberOfOtherBeingsNearby_DEPRECATED;
+	Placement.NumberOfSameBeingsNearby = NumberOfSameBeingsNearby_DEPRECATED;
+	Placement.ClusterRadius = ClusterRadius_DEPRECATED;
 
+	PlacementPass_DEPRECATED = 0.f;
 }
-void AFixedBeing::OnObjectSelected(UObject* Object)
+#endif
+
+FFixedBeingRules AFixedBeing::GetRules() const
 {
-	if(Object == this)
-	{
-		bIsSelected = true;
-	}
-	else if(bIsSelected && !IsSelected())
-	{
-		bIsSelected = false;
-	}
+	FFixedBeingRules Rules;
+	Rules.Class = GetClass();
+	Rules.bIsSpawnable = bIsSpawnable;
+	Rules.Frequency = Frequency;
+	Rules.FlatAffinity = FlatAffinity;
+	Rules.VerticalAffinity = VerticalAffinity;
+	Rules.DeepAffinity = DeepAffinity;
+	Rules.ShallowAffinity = ShallowAffinity;
+	Rules.OthersClusterAversion = OthersClusterAversion;
+	Rules.OthersClusterAfinity = OthersClusterAfinity;
+	Rules.SelfClusterAversion = SelfClusterAversion;
+	Rules.SelfClusterAfinity = SelfClusterAfinity;
+	Rules.MinimumSpacing = MinimumSpacing;
+	Rules.bCanBeUpsideDown = bCanBeUpsideDown;
+	return Rules;
 }
+
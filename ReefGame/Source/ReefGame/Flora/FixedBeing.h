@@ -6,6 +6,70 @@
 #include "GameFramework/Actor.h"
 #include "FixedBeing.generated.h"
 
+/**
+ * Why a fixed being ended up where it is, kept on the actor or, for instanced beings, next to the instance
+ */
+USTRUCT()
+struct FFixedBeingPlacement {
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, Category="Placement")
+	int ItemNumber = 0;
+	UPROPERTY(VisibleAnywhere, Category="Placement")
+	float SkewedDepthAffinity = 0.f;
+	UPROPERTY(VisibleAnywhere, Category="Placement")
+	float SkewedFlatnessAffinity = 0.f;
+	UPROPERTY(VisibleAnywhere, Category="Placement")
+	float SelfClusterPositiveScore = 0.f;
+	UPROPERTY(VisibleAnywhere, Category="Placement")
+	float SelfClusterNegativeScore = 0.f;
+	UPROPERTY(VisibleAnywhere, Category="Placement")
+	float OthersClusterPositiveScore = 0.f;
+	UPROPERTY(VisibleAnywhere, Category="Placement")
+	float OthersClusterNegativeScore = 0.f;
+	UPROPERTY(VisibleAnywhere, Category="Placement")
+	float PlacementPass = 0.f;
+	UPROPERTY(VisibleAnywhere, Category="Placement")
+	int64 NumberOfBeingsWhenPlaced = 0;
+	UPROPERTY(VisibleAnywhere, Category="Placement")
+	int64 NumberOfBeingsNearby = 0;
+	UPROPERTY(VisibleAnywhere, Category="Placement")
+	int64 NumberOfOtherBeingsNearby = 0;
+	UPROPERTY(VisibleAnywhere, Category="Placement")
+	int64 NumberOfSameBeingsNearby = 0;
+	UPROPERTY(VisibleAnywhere, Category="Placement")
+	float ClusterRadius = 0.f;
+};
+
+/**
+ * The placement rules of a fixed being, copied out of the actor so they can be read off the game thread
+ */
+struct FFixedBeingRules {
+	UClass* Class = nullptr;
+	bool    bIsSpawnable = true;
+	float   Frequency = 0.f;
+	float   FlatAffinity = 0.f;
+	float   VerticalAffinity = 0.f;
+	float   DeepAffinity = 0.f;
+	float   ShallowAffinity = 0.f;
+	float   OthersClusterAversion = 0.f;
+	float   OthersClusterAfinity = 0.f;
+	float   SelfClusterAversion = 0.f;
+	float   SelfClusterAfinity = 0.f;
+	float   MinimumSpacing = 0.f;
+	bool    bCanBeUpsideDown = true;
+
+	bool operator==(FFixedBeingRules const& Other) const
+	{
+		return Class == Other.Class && bIsSpawnable == Other.bIsSpawnable && Frequency == Other.Frequency
+		&& FlatAffinity == Other.FlatAffinity && VerticalAffinity == Other.VerticalAffinity
+		&& DeepAffinity == Other.DeepAffinity && ShallowAffinity == Other.ShallowAffinity
+		&& OthersClusterAversion == Other.OthersClusterAversion && OthersClusterAfinity == Other.OthersClusterAfinity
+		&& SelfClusterAversion == Other.SelfClusterAversion && SelfClusterAfinity == Other.SelfClusterAfinity
+		&& MinimumSpacing == Other.MinimumSpacing && bCanBeUpsideDown == Other.bCanBeUpsideDown;
+	}
+};
+
 UCLASS()
 class REEFGAME_API AFixedBeing : public AActor
 {
@@ -41,45 +105,50 @@ public:
 	bool bCanBeUpsideDown = true;
 	UPROPERTY(EditAnywhere, Category="Fauna/Flora")
 	bool bAlwaysPointUp = false;
+	// Keep a full actor even when the environment places its beings as instances, for beings with gameplay behaviour
+	UPROPERTY(EditAnywhere, Category="Fauna/Flora")
+	bool bNeedsActor = false;
 
 	UPROPERTY(VisibleAnywhere, Category="Placement")
-	int ItemNumber;
-	UPROPERTY(VisibleAnywhere, Category="Placement")
-	float SkewedDepthAffinity;
-	UPROPERTY (VisibleAnywhere, Category="Placement")
-	float SkewedFlatnessAffinity;
-	UPROPERTY (VisibleAnywhere, Category="Placement")
-	float SelfClusterPositiveScore;
-	UPROPERTY (VisibleAnywhere, Category="Placement")
-	float SelfClusterNegativeScore;
-	UPROPERTY (VisibleAnywhere, Category="Placement")
-	float OthersClusterPositiveScore;
-	UPROPERTY (VisibleAnywhere, Category="Placement")
-	float OthersClusterNegativeScore;
-	UPROPERTY(VisibleAnywhere, Category="Placement")
-	float PlacementPass;
-	UPROPERTY(VisibleAnywhere, Category="Placement")
-	int64 NumberOfBeingsWhenPlaced;
-	UPROPERTY(VisibleAnywhere, Category="Placement")
-	int64 NumberOfBeingsNearby;
-	UPROPERTY(VisibleAnywhere, Category="Placement")
-	int64 NumberOfOtherBeingsNearby;
-	UPROPERTY(VisibleAnywhere, Category="Placement")
-	int64 NumberOfSameBeingsNearby;
-	UPROPERTY(VisibleAnywhere, Category="Placement")
-	float ClusterRadius;
+	FFixedBeingPlacement Placement;
 
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
+	FFixedBeingRules GetRules() const;
 
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
-#if WITH_EDITOR
-	virtual bool ShouldTickIfViewportsOnly() const override;
-	void         OnObjectSelected(UObject* Object);
-	bool         bIsSelected = false;
-#endif
+#if WITH_EDITORONLY_DATA
+	virtual void PostLoad() override;
 
+private:
+	// The placement as it was saved before it moved into Placement, the CoreRedirects in DefaultEngine.ini load it here
+	UPROPERTY()
+	int ItemNumber_DEPRECATED = 0;
+	UPROPERTY()
+	float SkewedDepthAffinity_DEPRECATED = 0.f;
+	UPROPERTY()
+	float SkewedFlatnessAffinity_DEPRECATED = 0.f;
+	UPROPERTY()
+	float SelfClusterPositiveScore_DEPRECATED = 0.f;
+	UPROPERTY()
+	float SelfClusterNegativeScore_DEPRECATED = 0.f;
+	UPROPERTY()
+	float OthersClusterPositiveScore_DEPRECATED = 0.f;
+	UPROPERTY()
+	float OthersClusterNegativeScore_DEPRECATED = 0.f;
+	UPROPERTY()
+	float PlacementPass_DEPRECATED = 0.f;
+	UPROPERTY()
+	int64 NumberOfBeingsWhenPlaced_DEPRECATED = 0;
+	UPROPERTY()
+	int64 NumberOfBeingsNearby_DEPRECATED = 0;
+	UPROPERTY()
+	int64 NumberOfOtherBeingsNearby_DEPRECATED = 0;
+	UPROPERTY()
+	int64 NumberOfSameBeingsNearby_DEPRECATED = 0;
+	UPROPERTY()
+	float ClusterRadius_DEPRECATED = 0.f;
+#endif
 };
@@ -0,0 +1,50 @@
+#include "FixedBeingInstancesComponent.h"
+
+bool UFixedBeingInstancesComponent::SetTemplate(AFixedBeing const* Template)
+{
+	if(!Template)
+	{
+		return false;
+	}
+	const UStaticMeshComponent* Mesh = Template->FindComponentByClass<UStaticMeshComponent>();
+	if(!Mesh || !Mesh->GetStaticMesh())
+	{
+		return false;
+	}
+
+	SetStaticMesh(Mesh->GetStaticMesh());
+	for(int32 i = 0; i < Mesh->GetNumOverrideMaterials(); i++)
+	{
+		SetMaterial(i, Mesh->OverrideMaterials[i]);
+	}
+	SetCollisionProfileName(Mesh->GetCollisionProfileName());
+	SetCastShadow(Mesh->CastShadow);
+	MeshTransform = Mesh->GetComponentTransform().GetRelativeTransform(Template->GetActorTransform());
+	return true;
+}
+
+int32 UFixedBeingInstancesComponent::AddBeing(FTransform const& BeingTransform, FFixedBeingPlacement const& Placement)
+{
+	Placements.Add(Placement);
+	return AddInstance(MeshTransform * BeingTransform);
+}
+
+void UFixedBeingInstancesComponent::RemoveBeings(TArray<int32> const& Indices)
+{
+	TArray<int32> Sorted = Indices;
+	Sorted.Sort(TGreater<int32>());
+	for(const int32 Index : Sorted)
+	{
+		if(Placements.IsValidIndex(Index))
+		{
+			Placements.RemoveAt(Index);
+		}
+	}
+	RemoveInstances(Indices);
+}
+
+void UFixedBeingInstancesComponent::ClearBeings()
+{
+	ClearInstances();
+	Placements.Empty();
+}
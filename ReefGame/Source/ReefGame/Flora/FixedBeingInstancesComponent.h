@@ -0,0 +1,41 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "FixedBeing.h"
+#include "FixedBeingInstancesComponent.generated.h"
+
+/**
+ * All the instanced beings of one fixed being class, rendered from the static mesh of that class.
+ * Used instead of one actor per being when the environment places its beings as instances.
+ * Placements runs parallel to the instances and holds what the actor would otherwise show in its Placement category.
+ */
+UCLASS()
+class REEFGAME_API UFixedBeingInstancesComponent : public UHierarchicalInstancedStaticMeshComponent {
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(VisibleAnywhere, Category="Fixed Beings")
+	TSubclassOf<AFixedBeing> BeingClass;
+
+	UPROPERTY(VisibleAnywhere, Category="Fixed Beings")
+	TArray<FFixedBeingPlacement> Placements;
+
+	// Mesh of the being relative to its actor, applied under every instance
+	UPROPERTY()
+	FTransform MeshTransform;
+
+	/**
+	 * Take the mesh, materials and collision from the first static mesh of a being of the class.
+	 *
+	 * @param Template  A spawned being of BeingClass.
+	 * @return false if the being has no static mesh to instance
+	 */
+	bool SetTemplate(AFixedBeing const* Template);
+
+	// Location and rotation of the being relative to the component
+	int32 AddBeing(FTransform const& BeingTransform, FFixedBeingPlacement const& Placement);
+	// The indices of the beings after the removed ones go down by the number of removed ones before them
+	void  RemoveBeings(TArray<int32> const& Indices);
+	void  ClearBeings();
+};
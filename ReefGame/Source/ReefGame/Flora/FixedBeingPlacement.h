@@ -0,0 +1,15 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FixedBeingPlacement.generated.h"
+
+/**
+ * How the candidate locations of the fixed beings are generated
+ */
+UENUM()
+enum class EFixedBeingPlacement : uint8 {
+	// FixedBeingPlacingPasses stepped sweeps over the terrain grid, each finer than the last
+	Passes,
+	// A single blue noise sweep, no two candidates closer than the smallest MinimumSpacing
+	PoissonDisk
+};
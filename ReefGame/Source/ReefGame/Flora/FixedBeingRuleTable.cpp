@@ -0,0 +1,120 @@
+#include "FixedBeingRuleTable.h"
+#include "Math/VectorRegister.h"
+
+void FRuleScoringBatch::Reset(const int32 NewNum)
+{
+	NumOfCandidates = NewNum;
+	const int32 Padded = Align(NewNum, Width);
+
+	auto Size = [this, Padded](auto& Column, auto const Padding)
+	{
+		Column.SetNumUninitialized(Padded, false);
+		for(int32 i = NumOfCandidates; i < Padded; i++)
+		{
+			Column[i] = Padding;
+		}
+	};
+	Size(RuleIndices, 0);
+	Size(DepthPercentages, 0.f);
+	Size(Flatnesses, 0.f);
+	Size(OnTerrain, 0.f);
+	Size(UpsideDown, 0.f);
+	Size(FrequencyDraws, 0.f);
+	Size(DepthDraws, 0.f);
+	Size(SlopeDraws, 0.f);
+	Size(SkewedDepthAffinities, 0.f);
+	Size(SkewedFlatnessAffinities, 0.f);
+	Size(Accepted, false);
+}
+
+void FFixedBeingRuleTable::Build(TArrayView<const FFixedBeingRules> NewRules)
+{
+	Reset();
+	Rules.Append(NewRules.GetData(), NewRules.Num());
+
+	const int32 NumOfRules = Rules.Num();
+	Spawnable.Reserve(NumOfRules);
+	Frequency.Reserve(NumOfRules);
+	FlatAffinity.Reserve(NumOfRules);
+	VerticalAffinity.Reserve(NumOfRules);
+	DeepAffinity.Reserve(NumOfRules);
+	ShallowAffinity.Reserve(NumOfRules);
+	CanBeUpsideDown.Reserve(NumOfRules);
+
+	for(FFixedBeingRules const& Row : Rules)
+	{
+		Spawnable.Add(Row.Class && Row.bIsSpawnable ? 1.f : 0.f);
+		Frequency.Add(Row.Frequency);
+		FlatAffinity.Add(Row.FlatAffinity);
+		VerticalAffinity.Add(Row.VerticalAffinity);
+		DeepAffinity.Add(Row.DeepAffinity);
+		ShallowAffinity.Add(Row.ShallowAffinity);
+		CanBeUpsideDown.Add(Row.bCanBeUpsideDown ? 1.f : 0.f);
+	}
+}
+
+void FFixedBeingRuleTable::Reset()
+{
+	Rules.Reset();
+	Spawnable.Reset();
+	Frequency.Reset();
+	FlatAffinity.Reset();
+	VerticalAffinity.Reset();
+	DeepAffinity.Reset();
+	ShallowAffinity.Reset();
+	CanBeUpsideDown.Reset();
+}
+
+void FFixedBeingRuleTable::Score(FRuleScoringBatch& Batch) const
+{
+	const int32 Padded = Batch.RuleIndices.Num();
+	if(Rules.Num() == 0)
+	{
+		for(int32 i = 0; i < Padded; i++)
+		{
+			Batch.Accepted[i] = false;
+		}
+		return;
+	}
+
+	const VectorRegister4Float One = VectorOne();
+	const VectorRegister4Float Half = VectorSetFloat1(0.5f);
+
+	for(int32 i = 0; i < Padded; i += FRuleScoringBatch::Width)
+	{
+		// the rows of the four candidates, the table is a handful of rows so the gather stays in cache
+		const int32* Row = &Batch.RuleIndices[i];
+		auto Gather = [Row](TArray<float> const& Column)
+		{
+			return MakeVectorRegisterFloat(Column[Row[0]], Column[Row[1]], Column[Row[2]], Column[Row[3]]);
+		};
+
+		// Lerp(A, B, Alpha) as A + Alpha * (B - A), unfused like FMath::Lerp
+		const VectorRegister4Float Shallow = Gather(ShallowAffinity);
+		const VectorRegister4Float Vertical = Gather(VerticalAffinity);
+		const VectorRegister4Float SkewedDepth = VectorAdd(Shallow, VectorMultiply(VectorLoad(&Batch.DepthPercentages[i]), VectorSubtract(Gather(DeepAffinity), Shallow)));
+		const VectorRegister4Float SkewedFlatness = VectorAdd(Vertical, VectorMultiply(VectorLoad(&Batch.Flatnesses[i]), VectorSubtract(Gather(FlatAffinity), Vertical)));
+		VectorStore(SkewedDepth, &Batch.SkewedDepthAffinities[i]);
+		VectorStore(SkewedFlatness, &Batch.SkewedFlatnessAffinities[i]);
+
+		// off the terrain or not spawnable
+		VectorRegister4Float Rejected = VectorCompareGT(Half, VectorMultiply(VectorLoad(&Batch.OnTerrain[i]), Gather(Spawnable)));
+		Rejected = VectorBitwiseOr(Rejected, VectorCompareGT(VectorLoad(&Batch.FrequencyDraws[i]), Gather(Frequency)));
+		// upside down where it may not be
+		Rejected = VectorBitwiseOr(Rejected, VectorCompareGT(VectorMultiply(VectorLoad(&Batch.UpsideDown[i]), VectorSubtract(One, Gather(CanBeUpsideDown))), Half));
+		Rejected = VectorBitwiseOr(Rejected, VectorCompareGT(VectorLoad(&Batch.DepthDraws[i]), SkewedDepth));
+		Rejected = VectorBitwiseOr(Rejected, VectorCompareGT(VectorLoad(&Batch.SlopeDraws[i]), SkewedFlatness));
+
+		const int32 Mask = VectorMaskBits(Rejected);
+		for(int32 Lane = 0; Lane < FRuleScoringBatch::Width; Lane++)
+		{
+			Batch.Accepted[i + Lane] = (Mask & (1 << Lane)) == 0;
+		}
+	}
+}
+
+SIZE_T FFixedBeingRuleTable::GetAllocatedSize() const
+{
+	return Rules.GetAllocatedSize() + Spawnable.GetAllocatedSize() + Frequency.GetAllocatedSize() + FlatAffinity.GetAllocatedSize()
+		+ VerticalAffinity.GetAllocatedSize() + DeepAffinity.GetAllocatedSize() + ShallowAffinity.GetAllocatedSize() + CanBeUpsideDown.GetAllocatedSize();
+}
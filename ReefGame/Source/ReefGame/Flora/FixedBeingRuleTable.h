@@ -0,0 +1,69 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FixedBeing.h"
+
+/**
+ * The candidates of a batch as the rule table scores them, one entry per candidate and padded to whole vectors.
+ * Flags are 1 or 0 so that they are scored with the same vector maths as the draws.
+ */
+struct REEFGAME_API FRuleScoringBatch {
+	static constexpr int32 Width = 4;
+
+	TArray<int32> RuleIndices;
+	TArray<float> DepthPercentages;
+	TArray<float> Flatnesses;
+	TArray<float> OnTerrain;
+	TArray<float> UpsideDown;
+	TArray<float> FrequencyDraws;
+	TArray<float> DepthDraws;
+	TArray<float> SlopeDraws;
+
+	TArray<float> SkewedDepthAffinities;
+	TArray<float> SkewedFlatnessAffinities;
+	// Got past its rules and draws, only the terrain sample and the neighbours are left to check
+	TArray<bool>  Accepted;
+
+	// Size every column for a number of candidates, the padding is off the terrain so it is always rejected
+	void  Reset(int32 NewNum);
+	int32 Num() const { return NumOfCandidates; }
+
+private:
+	int32 NumOfCandidates = 0;
+};
+
+/**
+ * The placement rules of the picker buckets compiled into one column per rule, indexed by bucket.
+ * Built once per pass from the front of every bucket, so scoring a candidate never reads an actor.
+ */
+class REEFGAME_API FFixedBeingRuleTable {
+public:
+	void  Build(TArrayView<const FFixedBeingRules> NewRules);
+	void  Reset();
+	int32 Num() const { return Rules.Num(); }
+
+	// The rules a row was compiled from, to tell when a being has changed since
+	FFixedBeingRules const& GetRules(const int32 Index) const { return Rules[Index]; }
+
+	/**
+	 * Score a batch of candidates a vector at a time, the same arithmetic as EvaluateCandidate so both agree on every candidate.
+	 *
+	 * @param Batch  The candidates, their skewed affinities and whether they are accepted are written back to it.
+	 */
+	void Score(FRuleScoringBatch& Batch) const;
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	TArray<FFixedBeingRules> Rules;
+
+	// 1 if the bucket has a class and it is spawnable
+	TArray<float> Spawnable;
+	TArray<float> Frequency;
+	TArray<float> FlatAffinity;
+	TArray<float> VerticalAffinity;
+	TArray<float> DeepAffinity;
+	TArray<float> ShallowAffinity;
+	// 1 if the being may be placed on terrain facing down
+	TArray<float> CanBeUpsideDown;
+};
@@ -0,0 +1,80 @@
+#include "FixedBeingSpatialIndex.h"
+
+void FFixedBeingSpatialIndex::Reset(const float NewCellSize)
+{
+	CellSize = FMath::Max(NewCellSize, UE_KINDA_SMALL_NUMBER);
+	MaxMinimumSpacing = 0.f;
+	Entries.Reset();
+	Cells.Reset();
+}
+
+void FFixedBeingSpatialIndex::Add(const int32 Id, FVector const& Location, const float MinimumSpacing)
+{
+	const int32 Position = Entries.Add(FEntry{Id, Location});
+	Cells.FindOrAdd(GetCell(Location)).Add(Position);
+	MaxMinimumSpacing = FMath::Max(MaxMinimumSpacing, MinimumSpacing);
+}
+
+void FFixedBeingSpatialIndex::Gather(FVector const& Location, const float Radius, TArray<int32>& OutIds) const
+{
+	OutIds.Reset();
+	if(Entries.Num() == 0)
+	{
+		return;
+	}
+
+	// Slightly generous so rounding never drops an entry the caller's exact distance test would keep
+	const double RadiusSquared = FMath::Square(static_cast<double>(Radius)) * (1.0 + UE_KINDA_SMALL_NUMBER);
+
+	const FIntVector Min = GetCell(Location - FVector(Radius));
+	const FIntVector Max = GetCell(Location + FVector(Radius));
+	const int64 NumOfCells = static_cast<int64>(Max.X - Min.X + 1) * (Max.Y - Min.Y + 1) * (Max.Z - Min.Z + 1);
+
+	// A radius much larger than the cells would visit more cells than there are entries
+	if(NumOfCells > Entries.Num())
+	{
+		for(const FEntry& Entry : Entries)
+		{
+			if(FVector::DistSquared(Location, Entry.Location) <= RadiusSquared)
+			{
+				OutIds.Add(Entry.Id);
+			}
+		}
+		return;
+	}
+
+	TArray<int32, TInlineAllocator<64>> Positions;
+	for(int32 Z = Min.Z; Z <= Max.Z; Z++)
+	{
+		for(int32 Y = Min.Y; Y <= Max.Y; Y++)
+		{
+			for(int32 X = Min.X; X <= Max.X; X++)
+			{
+				const TArray<int32>* Cell = Cells.Find(FIntVector(X, Y, Z));
+				if(!Cell) continue;
+				for(const int32 Position : *Cell)
+				{
+					if(FVector::DistSquared(Location, Entries[Position].Location) <= RadiusSquared)
+					{
+						Positions.Add(Position);
+					}
+				}
+			}
+		}
+	}
+
+	Positions.Sort();
+	OutIds.Reserve(Positions.Num());
+	for(const int32 Position : Positions)
+	{
+		OutIds.Add(Entries[Position].Id);
+	}
+}
+
+FIntVector FFixedBeingSpatialIndex::GetCell(FVector const& Location) const
+{
+	return FIntVector(
+		FMath::FloorToInt32(Location.X / CellSize),
+		FMath::FloorToInt32(Location.Y / CellSize),
+		FMath::FloorToInt32(Location.Z / CellSize));
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Uniform hash grid over the placed fixed beings, so spacing and clustering checks only look at the beings around a candidate.
+ * The cell size is meant to be the cluster range, so a cluster query only touches the 3x3x3 cells around the candidate.
+ * Entries are identified by an id chosen by the caller, usually the index of the being in the spawned list.
+ */
+class REEFGAME_API FFixedBeingSpatialIndex {
+public:
+	void Reset(float NewCellSize);
+	void Add(int32 Id, FVector const& Location, float MinimumSpacing);
+
+	int32 Num() const { return Entries.Num(); }
+	float GetCellSize() const { return CellSize; }
+	// Largest MinimumSpacing added so far, a query has to reach at least this far to see every spacing conflict
+	float GetMaxMinimumSpacing() const { return MaxMinimumSpacing; }
+
+	/**
+	 * Collect the entries within Radius of Location, using squared distances.
+	 * The ids come out in the order they were added so that anything accumulated over them is independent of the hashing.
+	 *
+	 * @param Location  The centre of the query.
+	 * @param Radius  How far to look.
+	 * @param OutIds  The ids of the entries in range, emptied first.
+	 */
+	void Gather(FVector const& Location, float Radius, TArray<int32>& OutIds) const;
+
+private:
+	struct FEntry {
+		int32   Id;
+		FVector Location;
+	};
+
+	float CellSize = 1.f;
+	float MaxMinimumSpacing = 0.f;
+
+	// Insertion order, the position in this array is what the results are sorted by
+	TArray<FEntry> Entries;
+	// Positions in Entries by cell
+	TMap<FIntVector, TArray<int32>> Cells;
+
+	FIntVector GetCell(FVector const& Location) const;
+};
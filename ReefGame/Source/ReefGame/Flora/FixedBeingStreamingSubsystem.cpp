@@ -0,0 +1,198 @@
+#include "FixedBeingStreamingSubsystem.h"
+#include "FixedBeing.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+
+// Setup
+
+void UFixedBeingStreamingSubsystem::Configure(const float NewCellSize, const float NewActivationDistance, const float NewDeactivationMargin)
+{
+	ActivationDistance = FMath::Max(NewActivationDistance, 0.f);
+	DeactivationMargin = FMath::Max(NewDeactivationMargin, 0.f);
+
+	const float ClampedCellSize = FMath::Max(NewCellSize, 100.f);
+	if(ClampedCellSize == CellSize)
+	{
+		return;
+	}
+	CellSize = ClampedCellSize;
+
+	// regroup everything that registered with the old cells
+	TArray<AFixedBeing*> Beings;
+	for(auto& Pair : Cells)
+	{
+		SetCellActive(Pair.Value, true);
+		for(auto& WBeing : Pair.Value.Beings)
+		{
+			if(AFixedBeing* Being = WBeing.Get())
+			{
+				Beings.Add(Being);
+			}
+		}
+	}
+	Cells.Reset();
+	BeingCells.Reset();
+	for(AFixedBeing* Being : Beings)
+	{
+		Register(Being);
+	}
+	TimeSinceUpdate = UpdateInterval;
+}
+
+void UFixedBeingStreamingSubsystem::Register(AFixedBeing* Being)
+{
+	if(!Being || BeingCells.Contains(Being))
+	{
+		return;
+	}
+	const FIntPoint Cell = GetCell(Being->GetActorLocation());
+	BeingCells.Add(Being, Cell);
+
+	// joins in the state of its cell
+	FCell& Entry = Cells.FindOrAdd(Cell);
+	Entry.Beings.Add(Being);
+	if(!Entry.bActive)
+	{
+		FCell Single;
+		Single.Beings.Add(Being);
+		SetCellActive(Single, false);
+	}
+}
+
+void UFixedBeingStreamingSubsystem::Unregister(AFixedBeing* Being)
+{
+	FIntPoint Cell;
+	if(!Being || !BeingCells.RemoveAndCopyValue(Being, Cell))
+	{
+		return;
+	}
+	if(FCell* Entry = Cells.Find(Cell))
+	{
+		Entry->Beings.RemoveSingleSwap(Being);
+		if(Entry->Beings.Num() == 0)
+		{
+			Cells.Remove(Cell);
+		}
+	}
+}
+
+int32 UFixedBeingStreamingSubsystem::GetNumOfActiveCells() const
+{
+	int32 NumOfActiveCells = 0;
+	for(auto& Pair : Cells)
+	{
+		NumOfActiveCells += Pair.Value.bActive ? 1 : 0;
+	}
+	return NumOfActiveCells;
+}
+
+// Updates
+
+bool UFixedBeingStreamingSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UFixedBeingStreamingSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFixedBeingStreamingSubsystem, STATGROUP_Tickables);
+}
+
+void UFixedBeingStreamingSubsystem::Tick(const float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	TimeSinceUpdate += DeltaTime;
+	if(TimeSinceUpdate < UpdateInterval)
+	{
+		return;
+	}
+	TimeSinceUpdate = 0.f;
+	UpdateCells();
+}
+
+/**
+ * Activate the cells a player is close to and deactivate the ones every player is far from.
+ * Only the local players count, except on a listen server where the remote players are simulated as well.
+ * Without a player view, as on a dedicated server, every cell is active.
+ */
+void UFixedBeingStreamingSubsystem::UpdateCells()
+{
+	TArray<FVector> ViewLocations;
+	GatherViewLocations(ViewLocations);
+
+	const float ActivationDistanceSquared = FMath::Square(ActivationDistance);
+	const float DeactivationDistanceSquared = FMath::Square(ActivationDistance + DeactivationMargin);
+
+	for(auto& Pair : Cells)
+	{
+		FCell& Cell = Pair.Value;
+		if(ViewLocations.Num() == 0)
+		{
+			SetCellActive(Cell, true);
+			continue;
+		}
+
+		const FBox2D Bounds(FVector2D(Pair.Key) * CellSize, FVector2D(Pair.Key + FIntPoint(1, 1)) * CellSize);
+		float        DistanceSquared = TNumericLimits<float>::Max();
+		for(const FVector& ViewLocation : ViewLocations)
+		{
+			DistanceSquared = FMath::Min(DistanceSquared, static_cast<float>(Bounds.ComputeSquaredDistanceToPoint(FVector2D(ViewLocation))));
+		}
+
+		if(!Cell.bActive && DistanceSquared < ActivationDistanceSquared)
+		{
+			SetCellActive(Cell, true);
+		}
+		else if(Cell.bActive && DistanceSquared > DeactivationDistanceSquared)
+		{
+			SetCellActive(Cell, false);
+		}
+	}
+}
+
+void UFixedBeingStreamingSubsystem::GatherViewLocations(TArray<FVector>& OutLocations) const
+{
+	OutLocations.Reset();
+	const bool bAllPlayers = GetWorld()->GetNetMode() == NM_ListenServer;
+	for(auto Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		const APlayerController* PlayerController = Iterator->Get();
+		if(!PlayerController || (!bAllPlayers && !PlayerController->IsLocalController()))
+		{
+			continue;
+		}
+		FVector  Location;
+		FRotator Rotation;
+		PlayerController->GetPlayerViewPoint(Location, Rotation);
+		OutLocations.Add(Location);
+	}
+}
+
+void UFixedBeingStreamingSubsystem::SetCellActive(FCell& Cell, const bool bActive) const
+{
+	if(Cell.bActive == bActive)
+	{
+		return;
+	}
+	Cell.bActive = bActive;
+
+	// whatever the authority simulates, fish and remote pawns included, has to keep colliding with the reef,
+	// standalone games and listen servers alike, only a client can leave the collision of a dormant being off
+	const bool bKeepCollision = GetWorld()->GetNetMode() != NM_Client;
+	for(auto& WBeing : Cell.Beings)
+	{
+		if(AFixedBeing* Being = WBeing.Get())
+		{
+			Being->SetActorHiddenInGame(!bActive);
+			Being->SetActorEnableCollision(bActive || bKeepCollision);
+			// only the beings that tick at all are woken up again
+			Being->SetActorTickEnabled(bActive && Being->PrimaryActorTick.bStartWithTickEnabled);
+		}
+	}
+}
+
+FIntPoint UFixedBeingStreamingSubsystem::GetCell(FVector const& Location) const
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "FixedBeingStreamingSubsystem.generated.h"
+
+class AFixedBeing;
+
+/**
+ * Runtime registry of the fixed beings of a world, grouped into square cells on the XY plane.
+ * A cell is active (visible and ticking) while a local player views it from within the activation distance,
+ * and goes dormant once every local player is further than that plus a margin, so the cells at the edge do not flicker.
+ * Beings register themselves on BeginPlay and leave on EndPlay, so with World Partition only the beings of the loaded
+ * cells are ever in the registry and this thins them further. Dedicated servers have no local player and keep every being active,
+ * listen servers go by the views of every player. Only clients turn the collision of a dormant being off, wherever the game
+ * is simulated, standalone or on a server, the fish and the pawns keep colliding with every being.
+ * Instanced beings are left to the culling of their instance components.
+ */
+UCLASS()
+class REEFGAME_API UFixedBeingStreamingSubsystem : public UTickableWorldSubsystem {
+	GENERATED_BODY()
+
+	struct FCell {
+		TArray<TWeakObjectPtr<AFixedBeing>> Beings;
+		bool                                bActive = true;
+	};
+
+	TMap<FIntPoint, FCell> Cells;
+	// The cell each registered being was put in, beings do not move
+	TMap<TObjectKey<AFixedBeing>, FIntPoint> BeingCells;
+
+	float CellSize = 5000.f;
+	float ActivationDistance = 20000.f;
+	float DeactivationMargin = 2500.f;
+	// Seconds between two updates, the players do not cross a cell in less
+	float UpdateInterval = 0.5f;
+	float TimeSinceUpdate = 0.f;
+
+	FIntPoint GetCell(FVector const& Location) const;
+	void      GatherViewLocations(TArray<FVector>& OutLocations) const;
+	void      UpdateCells();
+	void      SetCellActive(FCell& Cell, bool bActive) const;
+
+public:
+	/**
+	 * Set how the beings are grouped and when they are active, the registered beings are regrouped if the cells change.
+	 *
+	 * @param NewCellSize  The side of a cell in units.
+	 * @param NewActivationDistance  A cell is activated once a local player is closer than this.
+	 * @param NewDeactivationMargin  A cell is deactivated once every local player is further than the activation distance plus this.
+	 */
+	void Configure(float NewCellSize, float NewActivationDistance, float NewDeactivationMargin);
+
+	void Register(AFixedBeing* Being);
+	void Unregister(AFixedBeing* Being);
+
+	int32 GetNumOfBeings() const { return BeingCells.Num(); }
+	int32 GetNumOfActiveCells() const;
+
+	virtual bool    DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void    Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+};
@@ -0,0 +1,44 @@
+#include "FixedBeingsSnapshot.h"
+#include "ReefGame/EnvironmentEditor.h"
+
+FArchive& operator<<(FArchive& Ar, FPlacementRecord& Record)
+{
+	FFixedBeingPlacement& Placement = Record.Placement;
+	Ar << Record.ClassIndex << Record.Location << Record.Rotation;
+	Ar << Placement.ItemNumber << Placement.SkewedDepthAffinity << Placement.SkewedFlatnessAffinity;
+	Ar << Placement.SelfClusterPositiveScore << Placement.SelfClusterNegativeScore;
+	Ar << Placement.OthersClusterPositiveScore << Placement.OthersClusterNegativeScore;
+	Ar << Placement.PlacementPass << Placement.NumberOfBeingsWhenPlaced << Placement.NumberOfBeingsNearby;
+	Ar << Placement.NumberOfOtherBeingsNearby << Placement.NumberOfSameBeingsNearby << Placement.ClusterRadius;
+	return Ar;
+}
+
+UFixedBeingsSnapshot::UFixedBeingsSnapshot()
+{
+	SetFlags(RF_Transactional);
+}
+
+void UFixedBeingsSnapshot::Serialize(FArchive& Ar)
+{
+	Super::Serialize(Ar);
+
+	if(Ar.IsTransacting())
+	{
+		Ar << Records;
+	}
+}
+
+#if WITH_EDITOR
+void UFixedBeingsSnapshot::PostEditUndo()
+{
+	Super::PostEditUndo();
+
+	AActor* Parent = GetTypedOuter<AActor>();
+	IEnvironmentEditor* const Editor = IEnvironmentEditor::Get();
+	if(!Parent || !Editor)
+	{
+		return;
+	}
+	Editor->RestorePlacement(*this, Parent);
+}
+#endif
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "FixedBeing.h"
+#include "FixedBeingsSnapshot.generated.h"
+
+/**
+ * One placed being as written to the placement cache, enough to put it back without evaluating anything
+ */
+struct FPlacementRecord {
+	int32                ClassIndex = 0;
+	FVector3f            Location = FVector3f::ZeroVector;
+	FQuat4f              Rotation = FQuat4f::Identity;
+	FFixedBeingPlacement Placement;
+
+	friend REEFGAME_API FArchive& operator<<(FArchive& Ar, FPlacementRecord& Record);
+};
+
+/**
+ * The placement of the fixed beings of an environment as a single undo entry.
+ * Regenerations run with undo recording suspended, so instead of every actor they touched, the transaction holds this
+ * snapshot before and after. Undoing or redoing puts the placement of the snapshot back.
+ * The records only go through transactions, they are not saved with the level, so every edit takes the snapshot before it
+ * from the beings that are actually placed.
+ */
+UCLASS()
+class REEFGAME_API UFixedBeingsSnapshot : public UObject {
+	GENERATED_BODY()
+
+public:
+	UFixedBeingsSnapshot();
+
+	UPROPERTY()
+	TArray<TSubclassOf<AFixedBeing>> Classes;
+
+	UPROPERTY()
+	bool bInstanced = false;
+
+	TArray<FPlacementRecord> Records;
+
+	virtual void Serialize(FArchive& Ar) override;
+
+#if WITH_EDITOR
+	virtual void PostEditUndo() override;
+#endif
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Independent random streams of the placement, each decision of a candidate draws from its own one
+ */
+enum class EPlacementStream : uint32 {
+	XStep,
+	YStep,
+	Picker,
+	Frequency,
+	Depth,
+	Slope,
+	SelfClusterNegative,
+	SelfClusterPositive,
+	OthersClusterNegative,
+	OthersClusterPositive,
+	Rotation,
+	PoissonStart,
+	PoissonActive,
+	PoissonAngle,
+	PoissonDistance
+};
+
+/**
+ * Counter based random numbers for the placement.
+ * Every number is a hash of the seed, the pass, the column and row of the candidate in its pass and the stream, so it can be
+ * evaluated on any thread, in any order, and adding a draw somewhere never shifts the numbers drawn anywhere else.
+ */
+struct FPlacementRandom {
+	// PCG output permutation of a single LCG step, a cheap hash with good avalanche
+	static uint32 Permute(uint32 Value)
+	{
+		const uint32 State = Value * 747796405u + 2891336453u;
+		const uint32 Word = ((State >> ((State >> 28u) + 4u)) ^ State) * 277803737u;
+		return (Word >> 22u) ^ Word;
+	}
+
+	static uint32 Hash(const int32 Seed, const int32 Pass, FIntPoint const Key, EPlacementStream const Stream)
+	{
+		uint32 Hash = Permute(static_cast<uint32>(Seed));
+		Hash = Permute(Hash + static_cast<uint32>(Pass));
+		Hash = Permute(Hash + static_cast<uint32>(Key.X));
+		Hash = Permute(Hash + static_cast<uint32>(Key.Y));
+		return Permute(Hash + static_cast<uint32>(Stream));
+	}
+
+	// Uniform in [0, 1)
+	static float Unit(const int32 Seed, const int32 Pass, FIntPoint const Key, EPlacementStream const Stream)
+	{
+		return (Hash(Seed, Pass, Key, Stream) >> 8) * (1.f / 16777216.f);
+	}
+};
@@ -0,0 +1,172 @@
+#include "PlacementRasters.h"
+#include "Async/ParallelFor.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "ReefGame/Terrain/TerrainGridCell.h"
+#include "ReefGame/Terrain/TerrainSurface.h"
+
+namespace
+{
+	// 0 is black and 1 is white
+	FColor ToGrey(const float Value)
+	{
+		const uint8 Grey = static_cast<uint8>(FMath::Clamp(Value, 0.f, 1.f) * 255.f + 0.5f);
+		return FColor(Grey, Grey, Grey);
+	}
+
+	// Negative values are blue, positive ones red
+	FColor ToSigned(const float Value)
+	{
+		const uint8 Intensity = static_cast<uint8>(FMath::Clamp(FMath::Abs(Value), 0.f, 1.f) * 255.f + 0.5f);
+		return Value < 0 ? FColor(0, 0, Intensity) : FColor(Intensity, 0, 0);
+	}
+}
+
+void FPlacementRasters::Build(FTerrainSurface const& Surface, const float MinZ, const float MaxZ)
+{
+	if(Surface.IsEmpty() || Surface.Num() != Surface.NumOfXVertices * Surface.NumOfYVertices)
+	{
+		Reset();
+		return;
+	}
+
+	NumOfXVertices = Surface.NumOfXVertices;
+	NumOfYVertices = Surface.NumOfYVertices;
+	NumOfXTiles = FMath::DivideAndRoundUp(NumOfXVertices, TileSize);
+	const int32 NumOfYTiles = FMath::DivideAndRoundUp(NumOfYVertices, TileSize);
+
+	// the tiles at the edges are padded, their texels past the grid are never read
+	Texels.Reset();
+	Texels.SetNumZeroed(NumOfXTiles * NumOfYTiles * TileSize * TileSize);
+
+	// one grid step is 1 / Density, the Laplacian is divided by the step squared
+	const float CurvatureScale = FMath::Square(Surface.Density);
+
+	ParallelFor(NumOfYVertices, [&](const int32 Y)
+	{
+		const int32 Up = FMath::Max(Y - 1, 0);
+		const int32 Down = FMath::Min(Y + 1, NumOfYVertices - 1);
+		for(int32 X = 0; X < NumOfXVertices; X++)
+		{
+			const int32 Index = X + Y * NumOfXVertices;
+			const int32 Left = FMath::Max(X - 1, 0);
+			const int32 Right = FMath::Min(X + 1, NumOfXVertices - 1);
+			const float Height = Surface.Heights[Index];
+
+			const float Laplacian = Surface.Heights[Left + Y * NumOfXVertices] + Surface.Heights[Right + Y * NumOfXVertices]
+				+ Surface.Heights[X + Up * NumOfXVertices] + Surface.Heights[X + Down * NumOfXVertices] - 4.f * Height;
+
+			FTexel& Texel = Texels[GetTexelIndex(X, Y)];
+			Texel.DepthPercentage = FFloat16(FTerrainSample::GetDepthPercentage(Height, MinZ, MaxZ));
+			Texel.NormalZ = FFloat16(static_cast<float>(Surface.GetNormal(Index).Z));
+			Texel.Curvature = FFloat16(Laplacian * CurvatureScale);
+		}
+	});
+}
+
+void FPlacementRasters::Reset()
+{
+	NumOfXVertices = 0;
+	NumOfYVertices = 0;
+	NumOfXTiles = 0;
+	Texels.Empty();
+}
+
+bool FPlacementRasters::Sample(const float X, const float Y, FPlacementRasterSample& OutSample) const
+{
+	if(!IsBuilt() || X < 0 || Y < 0 || X > NumOfXVertices - 1 || Y > NumOfYVertices - 1)
+	{
+		return false;
+	}
+
+	const int32 X0 = FMath::FloorToInt32(X);
+	const int32 X1 = FMath::Min(X0 + 1, NumOfXVertices - 1);
+	const int32 Y0 = FMath::FloorToInt32(Y);
+	const int32 Y1 = FMath::Min(Y0 + 1, NumOfYVertices - 1);
+	const float FracX = X - X0;
+	const float FracY = Y - Y0;
+
+	const FTexel& Texel00 = Texels[GetTexelIndex(X0, Y0)];
+	const FTexel& Texel01 = Texels[GetTexelIndex(X0, Y1)];
+	const FTexel& Texel10 = Texels[GetTexelIndex(X1, Y0)];
+	const FTexel& Texel11 = Texels[GetTexelIndex(X1, Y1)];
+
+	auto Interpolate = [&](FFloat16 FTexel::* Channel)
+	{
+		return FMath::Lerp(
+			FMath::Lerp((Texel00.*Channel).GetFloat(), (Texel01.*Channel).GetFloat(), FracY),
+			FMath::Lerp((Texel10.*Channel).GetFloat(), (Texel11.*Channel).GetFloat(), FracY),
+			FracX);
+	};
+
+	const float NormalZ = Interpolate(&FTexel::NormalZ);
+	OutSample.DepthPercentage = Interpolate(&FTexel::DepthPercentage);
+	OutSample.Flatness = FMath::Abs(NormalZ);
+	OutSample.bUpsideDown = NormalZ < 0;
+	OutSample.Curvature = Interpolate(&FTexel::Curvature);
+	return true;
+}
+
+bool FPlacementRasters::ExportDebugBitmaps(FString const& Directory) const
+{
+	if(!IsBuilt())
+	{
+		return false;
+	}
+
+	// the curvature has no fixed range, it is scaled by its largest magnitude
+	float MaxCurvature = UE_KINDA_SMALL_NUMBER;
+	for(const FTexel& Texel : Texels)
+	{
+		MaxCurvature = FMath::Max(MaxCurvature, FMath::Abs(Texel.Curvature.GetFloat()));
+	}
+
+	TArray<FColor> Depth;
+	TArray<FColor> Flatness;
+	TArray<FColor> UpsideDown;
+	TArray<FColor> Curvature;
+	const int32    NumOfPixels = NumOfXVertices * NumOfYVertices;
+	Depth.SetNumUninitialized(NumOfPixels);
+	Flatness.SetNumUninitialized(NumOfPixels);
+	UpsideDown.SetNumUninitialized(NumOfPixels);
+	Curvature.SetNumUninitialized(NumOfPixels);
+
+	for(int32 Y = 0; Y < NumOfYVertices; Y++)
+	{
+		for(int32 X = 0; X < NumOfXVertices; X++)
+		{
+			const FTexel& Texel = Texels[GetTexelIndex(X, Y)];
+			const float   NormalZ = Texel.NormalZ.GetFloat();
+			const int32   Pixel = X + Y * NumOfXVertices;
+			Depth[Pixel] = ToGrey(Texel.DepthPercentage.GetFloat());
+			Flatness[Pixel] = ToGrey(FMath::Abs(NormalZ));
+			UpsideDown[Pixel] = ToGrey(NormalZ < 0 ? 1.f : 0.f);
+			Curvature[Pixel] = ToSigned(Texel.Curvature.GetFloat() / MaxCurvature);
+		}
+	}
+
+	bool bWritten = true;
+	auto Write = [&](const TCHAR* Name, TArray<FColor> const& Pixels)
+	{
+		FString FileName;
+		if(FFileHelper::CreateBitmap(*FPaths::Combine(Directory, Name), NumOfXVertices, NumOfYVertices, Pixels.GetData(), nullptr, &IFileManager::Get(), &FileName))
+		{
+			UE_LOG(LogTemp, Log, TEXT("Wrote placement raster %s"), *FileName);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Failed to write placement raster %s"), Name);
+			bWritten = false;
+		}
+	};
+	Write(TEXT("Depth"), Depth);
+	Write(TEXT("Flatness"), Flatness);
+	Write(TEXT("UpsideDown"), UpsideDown);
+	Write(TEXT("Curvature"), Curvature);
+	return bWritten;
+}
+
+SIZE_T FPlacementRasters::GetAllocatedSize() const
+{
+	return Texels.GetAllocatedSize();
+}
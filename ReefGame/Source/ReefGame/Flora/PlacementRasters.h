@@ -0,0 +1,80 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/Float16.h"
+
+struct FTerrainSurface;
+
+/**
+ * What the placement draws of a candidate are tested against, interpolated from the rasters
+ */
+struct FPlacementRasterSample {
+	// 1.0 at the lowest point of the terrain, 0.0 at the highest
+	float DepthPercentage = 0.f;
+	// |Normal.Z|, 1.0 on flat ground and 0.0 on a wall
+	float Flatness = 0.f;
+	bool  bUpsideDown = false;
+	// Laplacian of the height, positive in hollows and negative on ridges
+	float Curvature = 0.f;
+};
+
+/**
+ * Per vertex terrain values the placement tests every candidate against, built once per terrain surface.
+ * Texels are half precision and stored in square tiles, so the four texels of a lookup are almost always in the same
+ * couple of cache lines, whatever row of the terrain the candidates are in.
+ */
+class REEFGAME_API FPlacementRasters {
+public:
+	static constexpr int32 TileSize = 8;
+
+	/**
+	 * Build the rasters from a terrain surface.
+	 *
+	 * @param Surface  The surface, one texel per vertex.
+	 * @param MinZ  The lowest point of the terrain.
+	 * @param MaxZ  The highest point of the terrain.
+	 */
+	void Build(FTerrainSurface const& Surface, float MinZ, float MaxZ);
+	void Reset();
+	bool IsBuilt() const { return Texels.Num() > 0; }
+
+	/**
+	 * Bilinear lookup, the same cell and weights as FTerrainGridCell.
+	 *
+	 * @param X  The X coordinate in vertices.
+	 * @param Y  The Y coordinate in vertices.
+	 * @param OutSample  The interpolated values, only set if the point is inside the rasters.
+	 * @return false if the point is outside the rasters.
+	 */
+	bool Sample(float X, float Y, FPlacementRasterSample& OutSample) const;
+
+	/**
+	 * Write every raster as a bitmap for inspection.
+	 *
+	 * @param Directory  Where the bitmaps go, one per raster.
+	 * @return false if any of them could not be written.
+	 */
+	bool ExportDebugBitmaps(FString const& Directory) const;
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	struct FTexel {
+		FFloat16 DepthPercentage;
+		FFloat16 NormalZ;
+		FFloat16 Curvature;
+		FFloat16 Padding;
+	};
+
+	int32 NumOfXVertices = 0;
+	int32 NumOfYVertices = 0;
+	int32 NumOfXTiles = 0;
+
+	TArray<FTexel> Texels;
+
+	int32 GetTexelIndex(const int32 X, const int32 Y) const
+	{
+		const int32 Tile = (Y / TileSize) * NumOfXTiles + X / TileSize;
+		return Tile * TileSize * TileSize + (Y % TileSize) * TileSize + X % TileSize;
+	}
+};
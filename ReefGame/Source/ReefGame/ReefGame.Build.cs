@@ -11,7 +11,7 @@ public class ReefGame : ModuleRules
 		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "AIModule", "Niagara", "EnhancedInput", "UMG" });
 
 		PrivateDependencyModuleNames.AddRange(new string[] {
-			"ProceduralMeshComponent", "UnrealEd"
+			"ProceduralMeshComponent"
 		});
 
 		// Uncomment if you are using Slate UI
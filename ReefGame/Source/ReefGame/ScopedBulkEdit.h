@@ -0,0 +1,32 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/ITransaction.h"
+
+/**
+ * Suspends undo recording for as long as it lives, so a regeneration that spawns, moves and attaches thousands of actors
+ * does not fill the undo buffer and slow down every transaction after it.
+ * Whoever opens one records what an undo needs on their own, usually a compact snapshot of the result.
+ */
+class FScopedBulkEdit {
+public:
+	explicit FScopedBulkEdit(const bool bEnabled = true)
+		: PreviousUndo(GUndo)
+	{
+		if(bEnabled)
+		{
+			GUndo = nullptr;
+		}
+	}
+
+	~FScopedBulkEdit()
+	{
+		GUndo = PreviousUndo;
+	}
+
+	FScopedBulkEdit(FScopedBulkEdit const&) = delete;
+	FScopedBulkEdit& operator=(FScopedBulkEdit const&) = delete;
+
+private:
+	ITransaction* PreviousUndo;
+};
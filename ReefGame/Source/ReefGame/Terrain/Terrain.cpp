@@ -10,6 +10,8 @@ ATerrain::ATerrain()
 	PrimaryActorTick.bCanEverTick = true;
 
 	ProceduralMesh = CreateDefaultSubobject<UProceduralMeshComponent>(TEXT("Procedural Mesh"));
+	// Cook the collision on a background thread instead of hitching the game thread on every regeneration
+	ProceduralMesh->bUseAsyncCooking = true;
 	SetRootComponent(ProceduralMesh);
 }
 
@@ -19,6 +19,9 @@ public:
 
 	UPROPERTY(VisibleAnywhere, Category = "Mesh")
 	UProceduralMeshComponent* ProceduralMesh;
+
+	// Section 0 is rendered without collision, this hidden section holds the decimated collision surface
+	static constexpr int32 CollisionSectionIndex = 1;
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
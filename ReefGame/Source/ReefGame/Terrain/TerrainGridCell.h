@@ -0,0 +1,109 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Everything placement and gameplay want to know about one point of the terrain, fetched in one go
+ */
+struct FTerrainSample {
+	FVector Position = FVector::ZeroVector;
+	FVector Normal = FVector::ZeroVector;
+	// 1.0 at the lowest point of the terrain, 0.0 at the highest
+	float DepthPercentage = 0.f;
+	// false if the point was outside of the terrain, everything else is then zero
+	bool bValid = false;
+
+	// Depth percentage of a height between the lowest and highest point of the terrain
+	static float GetDepthPercentage(const float Z, const float MinZ, const float MaxZ)
+	{
+		const float HeightRange = MaxZ - MinZ;
+		if(HeightRange > SMALL_NUMBER)
+		{
+			return 1.f - ((Z - MinZ) / HeightRange);
+		}
+		return 0.f;
+	}
+};
+
+/**
+ * The four vertices around a point of a NumOfXVertices x NumOfYVertices terrain grid and the weights to interpolate between them.
+ * Shared by everything that samples per vertex terrain data, in the editor and at runtime.
+ */
+struct FTerrainGridCell {
+	int32 Index00;
+	int32 Index01;
+	int32 Index10;
+	int32 Index11;
+	float FracX;
+	float FracY;
+
+	/**
+	 * Find the cell containing a point of the grid.
+	 *
+	 * @param X  The X coordinate in vertices.
+	 * @param Y  The Y coordinate in vertices.
+	 * @param NumOfXVertices  The width of the grid.
+	 * @param NumOfYVertices  The height of the grid.
+	 * @param OutCell  The cell, only set if the point is inside the grid.
+	 * @return false if the point is outside the grid.
+	 */
+	static bool Find(const float X, const float Y, const int32 NumOfXVertices, const int32 NumOfYVertices, FTerrainGridCell& OutCell)
+	{
+		if(X < 0 || Y < 0 || X > NumOfXVertices - 1 || Y > NumOfYVertices - 1)
+		{
+			return false;
+		}
+
+		const int32 X0 = FMath::FloorToInt(X);
+		const int32 X1 = X < NumOfXVertices - 1 ? FMath::CeilToInt(X) : NumOfXVertices - 1;
+		const int32 Y0 = FMath::FloorToInt(Y);
+		const int32 Y1 = Y < NumOfYVertices - 1 ? FMath::CeilToInt(Y) : NumOfYVertices - 1;
+
+		OutCell.Index00 = X0 + Y0 * NumOfXVertices;
+		OutCell.Index01 = X0 + Y1 * NumOfXVertices;
+		OutCell.Index10 = X1 + Y0 * NumOfXVertices;
+		OutCell.Index11 = X1 + Y1 * NumOfXVertices;
+		OutCell.FracX = X - X0;
+		OutCell.FracY = Y - Y0;
+		return true;
+	}
+
+	// Bilinear interpolation of the values at the four vertices of the cell
+	template <typename T>
+	T Interpolate(TArray<T> const& Values) const
+	{
+		return InterpolateBy([&Values](const int32 Index) { return Values[Index]; });
+	}
+
+	// Bilinear interpolation of per vertex values that are not stored as they are, GetValue returns the value of a vertex by index
+	template <typename GetterType>
+	auto InterpolateBy(GetterType&& GetValue) const
+	{
+		return FMath::Lerp(
+			FMath::Lerp(GetValue(Index00), GetValue(Index01), FracY),
+			FMath::Lerp(GetValue(Index10), GetValue(Index11), FracY),
+			FracX);
+	}
+
+	// Position, normal and depth percentage of the cell with a single fetch of each vertex
+	template <typename VectorType>
+	FTerrainSample Sample(TArray<VectorType> const& Vertices, TArray<VectorType> const& Normals, const float MinZ, const float MaxZ) const
+	{
+		return SampleBy(
+			[&Vertices](const int32 Index) { return Vertices[Index]; },
+			[&Normals](const int32 Index) { return Normals[Index]; },
+			MinZ, MaxZ);
+	}
+
+	// Sample with the vertex positions and normals fetched through getters
+	template <typename VertexGetterType, typename NormalGetterType>
+	FTerrainSample SampleBy(VertexGetterType&& GetVertex, NormalGetterType&& GetNormal, const float MinZ, const float MaxZ) const
+	{
+		FTerrainSample Result;
+		Result.bValid = true;
+		Result.Position = FVector(InterpolateBy(GetVertex));
+		Result.Normal = FVector(InterpolateBy(GetNormal)).GetSafeNormal();
+		Result.DepthPercentage = FTerrainSample::GetDepthPercentage(Result.Position.Z, MinZ, MaxZ);
+		return Result;
+	}
+};
@@ -0,0 +1,275 @@
+#include "TerrainHeightPyramid.h"
+
+namespace
+{
+	/**
+	 * Segment against box slab test.
+	 *
+	 * @return The fraction of the segment where it enters the box, or a negative value if it misses it or enters after MaxTime
+	 */
+	float SegmentEntersBox(FVector3f const& Start, FVector3f const& InvDirection, FBox3f const& Box, const float MaxTime)
+	{
+		float TMin = 0.f;
+		float TMax = MaxTime;
+		for(int32 Axis = 0; Axis < 3; Axis++)
+		{
+			const float T0 = (Box.Min[Axis] - Start[Axis]) * InvDirection[Axis];
+			const float T1 = (Box.Max[Axis] - Start[Axis]) * InvDirection[Axis];
+			TMin = FMath::Max(TMin, FMath::Min(T0, T1));
+			TMax = FMath::Min(TMax, FMath::Max(T0, T1));
+			if(TMin > TMax)
+			{
+				return -1.f;
+			}
+		}
+		return TMin;
+	}
+
+	/**
+	 * Moller-Trumbore segment against triangle.
+	 *
+	 * @return The fraction of the segment where it hits the triangle, or a negative value if it misses it
+	 */
+	float SegmentHitsTriangle(FVector const& Start, FVector const& Direction, FVector const& A, FVector const& B, FVector const& C)
+	{
+		const FVector Edge1 = B - A;
+		const FVector Edge2 = C - A;
+		const FVector P = FVector::CrossProduct(Direction, Edge2);
+		const double  Determinant = FVector::DotProduct(Edge1, P);
+		if(FMath::Abs(Determinant) < UE_DOUBLE_SMALL_NUMBER)
+		{
+			return -1.f;
+		}
+		const double  InvDeterminant = 1.0 / Determinant;
+		const FVector ToStart = Start - A;
+		const double  U = FVector::DotProduct(ToStart, P) * InvDeterminant;
+		if(U < 0.0 || U > 1.0)
+		{
+			return -1.f;
+		}
+		const FVector Q = FVector::CrossProduct(ToStart, Edge1);
+		const double  V = FVector::DotProduct(Direction, Q) * InvDeterminant;
+		if(V < 0.0 || U + V > 1.0)
+		{
+			return -1.f;
+		}
+		const double T = FVector::DotProduct(Edge2, Q) * InvDeterminant;
+		return T >= 0.0 && T <= 1.0 ? T : -1.f;
+	}
+}
+
+/**
+ * Build the pyramid from the terrain grid.
+ *
+ * @param NewNumOfXVertices  The width of the grid.
+ * @param NewNumOfYVertices  The height of the grid.
+ * @param GetVertex  The position of a vertex by index.
+ */
+void FTerrainHeightPyramid::Build(const int32 NewNumOfXVertices, const int32 NewNumOfYVertices, FVertexGetter GetVertex)
+{
+	Reset();
+	if(NewNumOfXVertices < 2 || NewNumOfYVertices < 2)
+	{
+		return;
+	}
+	NumOfXVertices = NewNumOfXVertices;
+	NumOfYVertices = NewNumOfYVertices;
+
+	// Level 0, one node per cell
+	FLevel& Cells = Levels.AddDefaulted_GetRef();
+	Cells.NumOfX = NumOfXVertices - 1;
+	Cells.NumOfY = NumOfYVertices - 1;
+	Cells.Bounds.SetNumUninitialized(Cells.NumOfX * Cells.NumOfY);
+	for(int32 y = 0; y < Cells.NumOfY; y++)
+	{
+		for(int32 x = 0; x < Cells.NumOfX; x++)
+		{
+			FBox3f Box(ForceInit);
+			Box += FVector3f(GetVertex(x + y * NumOfXVertices));
+			Box += FVector3f(GetVertex(x + 1 + y * NumOfXVertices));
+			Box += FVector3f(GetVertex(x + (y + 1) * NumOfXVertices));
+			Box += FVector3f(GetVertex(x + 1 + (y + 1) * NumOfXVertices));
+			Cells.Bounds[x + y * Cells.NumOfX] = Box;
+		}
+	}
+
+	// Merge 2x2 nodes until a single node covers everything
+	while(Levels.Last().NumOfX > 1 || Levels.Last().NumOfY > 1)
+	{
+		const int32 Below = Levels.Num() - 1;
+		FLevel      Level;
+		Level.NumOfX = FMath::DivideAndRoundUp(Levels[Below].NumOfX, 2);
+		Level.NumOfY = FMath::DivideAndRoundUp(Levels[Below].NumOfY, 2);
+		Level.Bounds.Init(FBox3f(ForceInit), Level.NumOfX * Level.NumOfY);
+
+		const FLevel& Children = Levels[Below];
+		for(int32 y = 0; y < Children.NumOfY; y++)
+		{
+			for(int32 x = 0; x < Children.NumOfX; x++)
+			{
+				Level.Bounds[x / 2 + (y / 2) * Level.NumOfX] += Children.Bounds[x + y * Children.NumOfX];
+			}
+		}
+		Levels.Add(MoveTemp(Level));
+	}
+}
+
+void FTerrainHeightPyramid::Reset()
+{
+	Levels.Empty();
+	NumOfXVertices = 0;
+	NumOfYVertices = 0;
+}
+
+/**
+ * Depth first walk from the top of the pyramid.
+ *
+ * @param ShouldDescend  Called with the bounds of every node reached, return false to skip the node and everything below it.
+ * @param VisitCell  Called for every grid cell whose node was descended into.
+ */
+template <typename VisitorType>
+void FTerrainHeightPyramid::Traverse(VisitorType&& ShouldDescend, TFunctionRef<void(int32 CellX, int32 CellY)> VisitCell) const
+{
+	struct FNode {
+		int32 Level;
+		int32 X;
+		int32 Y;
+	};
+	TArray<FNode, TInlineAllocator<64>> Stack;
+	Stack.Add({Levels.Num() - 1, 0, 0});
+
+	while(Stack.Num() > 0)
+	{
+		const FNode   Node = Stack.Pop(false);
+		const FLevel& Level = Levels[Node.Level];
+		if(!ShouldDescend(Level.Bounds[Node.X + Node.Y * Level.NumOfX]))
+		{
+			continue;
+		}
+
+		if(Node.Level == 0)
+		{
+			VisitCell(Node.X, Node.Y);
+			continue;
+		}
+
+		const FLevel& Children = Levels[Node.Level - 1];
+		for(int32 y = Node.Y * 2; y < FMath::Min(Node.Y * 2 + 2, Children.NumOfY); y++)
+		{
+			for(int32 x = Node.X * 2; x < FMath::Min(Node.X * 2 + 2, Children.NumOfX); x++)
+			{
+				Stack.Add({Node.Level - 1, x, y});
+			}
+		}
+	}
+}
+
+/**
+ * Find the first point where a segment hits the terrain, conservatively skipping every node whose bounds it misses.
+ *
+ * @param Start  The start of the segment in terrain space.
+ * @param End  The end of the segment in terrain space.
+ * @param GetVertex  The position of a vertex by index, the same the pyramid was built from.
+ * @param OutHit  The closest hit, only set if there is one.
+ * @return true if the segment hits the terrain.
+ */
+bool FTerrainHeightPyramid::Raycast(FVector const& Start, FVector const& End, FVertexGetter GetVertex, FTerrainRayHit& OutHit) const
+{
+	if(!IsBuilt())
+	{
+		return false;
+	}
+
+	const FVector   Direction = End - Start;
+	const FVector3f Start3f(Start);
+	const FVector3f InvDirection(
+		Direction.X != 0 ? 1.f / Direction.X : BIG_NUMBER,
+		Direction.Y != 0 ? 1.f / Direction.Y : BIG_NUMBER,
+		Direction.Z != 0 ? 1.f / Direction.Z : BIG_NUMBER);
+
+	float   ClosestTime = 2.f;
+	FVector ClosestNormal = FVector::ZeroVector;
+
+	Traverse(
+		[&](FBox3f const& Box)
+		{
+			return SegmentEntersBox(Start3f, InvDirection, Box, FMath::Min(ClosestTime, 1.f)) >= 0.f;
+		},
+		[&](const int32 CellX, const int32 CellY)
+		{
+			const FVector V00 = GetVertex(CellX + CellY * NumOfXVertices);
+			const FVector V10 = GetVertex(CellX + 1 + CellY * NumOfXVertices);
+			const FVector V01 = GetVertex(CellX + (CellY + 1) * NumOfXVertices);
+			const FVector V11 = GetVertex(CellX + 1 + (CellY + 1) * NumOfXVertices);
+
+			// same triangles as the mesh
+			const FVector Triangles[2][3] = {{V00, V01, V10}, {V10, V01, V11}};
+			for(const auto& Triangle : Triangles)
+			{
+				const float Time = SegmentHitsTriangle(Start, Direction, Triangle[0], Triangle[1], Triangle[2]);
+				if(Time >= 0.f && Time < ClosestTime)
+				{
+					ClosestTime = Time;
+					ClosestNormal = FVector::CrossProduct(Triangle[2] - Triangle[0], Triangle[1] - Triangle[0]).GetSafeNormal();
+				}
+			}
+		});
+
+	if(ClosestTime > 1.f)
+	{
+		return false;
+	}
+
+	OutHit.Time = ClosestTime;
+	OutHit.Location = Start + Direction * ClosestTime;
+	OutHit.Normal = ClosestNormal;
+	return true;
+}
+
+/**
+ * Check whether a sphere touches the terrain.
+ *
+ * @param Centre  The centre of the sphere in terrain space.
+ * @param Radius  The radius of the sphere.
+ * @param GetVertex  The position of a vertex by index, the same the pyramid was built from.
+ * @return true if any triangle of the terrain is within the sphere.
+ */
+bool FTerrainHeightPyramid::SphereOverlaps(FVector const& Centre, const float Radius, FVertexGetter GetVertex) const
+{
+	if(!IsBuilt())
+	{
+		return false;
+	}
+
+	const FVector3f Centre3f(Centre);
+	const float     RadiusSquared = Radius * Radius;
+	bool            bOverlaps = false;
+
+	Traverse(
+		[&](FBox3f const& Box)
+		{
+			return !bOverlaps && Box.ComputeSquaredDistanceToPoint(Centre3f) <= RadiusSquared;
+		},
+		[&](const int32 CellX, const int32 CellY)
+		{
+			const FVector V00 = GetVertex(CellX + CellY * NumOfXVertices);
+			const FVector V10 = GetVertex(CellX + 1 + CellY * NumOfXVertices);
+			const FVector V01 = GetVertex(CellX + (CellY + 1) * NumOfXVertices);
+			const FVector V11 = GetVertex(CellX + 1 + (CellY + 1) * NumOfXVertices);
+
+			bOverlaps = FVector::DistSquared(FMath::ClosestPointOnTriangleToPoint(Centre, V00, V01, V10), Centre) <= RadiusSquared
+			|| FVector::DistSquared(FMath::ClosestPointOnTriangleToPoint(Centre, V10, V01, V11), Centre) <= RadiusSquared;
+		});
+
+	return bOverlaps;
+}
+
+SIZE_T FTerrainHeightPyramid::GetAllocatedSize() const
+{
+	SIZE_T Size = Levels.GetAllocatedSize();
+	for(const FLevel& Level : Levels)
+	{
+		Size += Level.Bounds.GetAllocatedSize();
+	}
+	return Size;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Result of a ray query against the terrain, in terrain space
+ */
+struct FTerrainRayHit {
+	FVector Location = FVector::ZeroVector;
+	FVector Normal = FVector::ZeroVector;
+	// Fraction of the segment where the hit happened, 0 at the start and 1 at the end
+	float Time = 1.f;
+};
+
+/**
+ * Hierarchical min/max bounds over the terrain grid.
+ * Level 0 holds the bounds of every grid cell (two triangles), each level above merges 2x2 nodes of the one below,
+ * up to a single node covering the whole terrain. Bounds are full 3D boxes so the XY displacement of the cliffs is covered too.
+ * Ray and sphere queries descend only into the nodes they touch, which makes them O(log n) on average,
+ * and never go through physics.
+ */
+class REEFGAME_API FTerrainHeightPyramid {
+public:
+	// Vertex position in terrain space by grid index
+	using FVertexGetter = TFunctionRef<FVector(int32 Index)>;
+
+	void Build(int32 NewNumOfXVertices, int32 NewNumOfYVertices, FVertexGetter GetVertex);
+	void Reset();
+	bool IsBuilt() const { return Levels.Num() > 0; }
+
+	bool Raycast(FVector const& Start, FVector const& End, FVertexGetter GetVertex, FTerrainRayHit& OutHit) const;
+	bool SphereOverlaps(FVector const& Centre, float Radius, FVertexGetter GetVertex) const;
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	struct FLevel {
+		int32           NumOfX = 0;
+		int32           NumOfY = 0;
+		TArray<FBox3f> Bounds;
+	};
+
+	int32 NumOfXVertices = 0;
+	int32 NumOfYVertices = 0;
+
+	// Levels[0] is the finest, one node per grid cell
+	TArray<FLevel> Levels;
+
+	template <typename VisitorType>
+	void Traverse(VisitorType&& ShouldDescend, TFunctionRef<void(int32 CellX, int32 CellY)> VisitCell) const;
+};
@@ -0,0 +1,10 @@
+#include "TerrainHeightfield.h"
+
+/**
+ * @return true if the heightfield has been baked and its arrays match its dimensions
+ */
+bool UTerrainHeightfield::IsValidHeightfield() const
+{
+	const int32 NumOfVertices = NumOfXVertices * NumOfYVertices;
+	return NumOfVertices > 0 && Density > 0.f && Vertices.Num() == NumOfVertices && Normals.Num() == NumOfVertices;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "TerrainHeightfield.generated.h"
+
+/**
+ * The generated terrain baked into an asset, so that it can be queried in packaged games and on dedicated servers
+ * where the editor terrain manager does not exist.
+ * Positions and normals are in terrain space, on the same NumOfXVertices x NumOfYVertices grid as the editor.
+ */
+UCLASS(BlueprintType)
+class REEFGAME_API UTerrainHeightfield : public UDataAsset {
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(VisibleAnywhere, Category = "Heightfield")
+	int32 NumOfXVertices = 0;
+	UPROPERTY(VisibleAnywhere, Category = "Heightfield")
+	int32 NumOfYVertices = 0;
+
+	// Vertices per unit, converts terrain space to grid coordinates
+	UPROPERTY(VisibleAnywhere, Category = "Heightfield")
+	float Density = 0.f;
+
+	UPROPERTY(VisibleAnywhere, Category = "Heightfield")
+	FBox Bounds = FBox(ForceInit);
+
+	UPROPERTY()
+	TArray<FVector3f> Vertices;
+
+	UPROPERTY()
+	TArray<FVector3f> Normals;
+
+	bool IsValidHeightfield() const;
+};
@@ -0,0 +1,230 @@
+#include "TerrainQuadtreeMesh.h"
+
+/**
+ * @param InVertices  The full resolution grid, row by row. Has to outlive the triangulator.
+ * @param InNumOfXVertices  The width of the grid.
+ * @param InNumOfYVertices  The height of the grid.
+ * @param InTolerance  How far, in units, a grid vertex may be from the simplified surface.
+ */
+FTerrainQuadtreeMesh::FTerrainQuadtreeMesh(TArray<FVector> const& InVertices, const int32 InNumOfXVertices, const int32 InNumOfYVertices,
+                                           const float InTolerance)
+	: Vertices(InVertices),
+	  NumOfXVertices(InNumOfXVertices),
+	  NumOfYVertices(InNumOfYVertices),
+	  NumOfXCells(InNumOfXVertices - 1),
+	  NumOfYCells(InNumOfYVertices - 1),
+	  Tolerance(InTolerance)
+{
+}
+
+/**
+ * Build the index buffer.
+ *
+ * @param OutTriangles  The triangles, with the same winding as the full grid.
+ * @param IsCancelled  Polled between the steps, returning true abandons the triangulation.
+ * @return false if the grid is too small or the triangulation was cancelled.
+ */
+bool FTerrainQuadtreeMesh::Triangulate(TArray<int32>& OutTriangles, TFunctionRef<bool()> IsCancelled)
+{
+	if(NumOfXCells < 1 || NumOfYCells < 1 || Vertices.Num() != NumOfXVertices * NumOfYVertices)
+	{
+		UE_LOG(LogTemp, Error, TEXT("TerrainQuadtreeMesh: Invalid %dx%d grid"), NumOfXVertices, NumOfYVertices);
+		return false;
+	}
+
+	// Subdivide by error from a root that covers the whole grid
+	LeafSizes.SetNumUninitialized(NumOfXCells * NumOfYCells);
+	Refine(0, 0, FMath::RoundUpToPowerOfTwo(FMath::Max(NumOfXCells, NumOfYCells)));
+	if(IsCancelled())
+	{
+		return false;
+	}
+
+	// Restrict the quadtree, split any leaf with a neighbour more than one level finer until there are none left.
+	// Splitting only ever makes leaves smaller, so this settles after a few sweeps.
+	bool bChanged = true;
+	while(bChanged)
+	{
+		bChanged = false;
+		for(int32 y = 0; y < NumOfYCells; y++)
+		{
+			for(int32 x = 0; x < NumOfXCells; x++)
+			{
+				const int32 Size = GetLeafSize(x, y);
+				// only look at each leaf once, from its origin
+				if(Size > 1 && (x & (Size - 1)) == 0 && (y & (Size - 1)) == 0 && NeedsSplit(x, y, Size))
+				{
+					const int32 HalfSize = Size / 2;
+					SetLeaf(x, y, HalfSize);
+					SetLeaf(x + HalfSize, y, HalfSize);
+					SetLeaf(x, y + HalfSize, HalfSize);
+					SetLeaf(x + HalfSize, y + HalfSize, HalfSize);
+					bChanged = true;
+				}
+			}
+		}
+		if(IsCancelled())
+		{
+			return false;
+		}
+	}
+
+	OutTriangles.Reset();
+	for(int32 y = 0; y < NumOfYCells; y++)
+	{
+		for(int32 x = 0; x < NumOfXCells; x++)
+		{
+			const int32 Size = GetLeafSize(x, y);
+			if((x & (Size - 1)) == 0 && (y & (Size - 1)) == 0)
+			{
+				AddLeafTriangles(x, y, Size, OutTriangles);
+			}
+		}
+	}
+	return !IsCancelled();
+}
+
+bool FTerrainQuadtreeMesh::IsInside(const int32 X, const int32 Y, const int32 Size) const
+{
+	return X + Size <= NumOfXCells && Y + Size <= NumOfYCells;
+}
+
+bool FTerrainQuadtreeMesh::IsOutside(const int32 X, const int32 Y, const int32 Size) const
+{
+	return X >= NumOfXCells || Y >= NumOfYCells;
+}
+
+/**
+ * The largest distance between a grid vertex of the node and the bilinear surface through the node's corners.
+ * The displacement of the cliffs is part of the positions, so overhangs count as error too.
+ */
+float FTerrainQuadtreeMesh::GetError(const int32 X, const int32 Y, const int32 Size) const
+{
+	const FVector& V00 = Vertices[GetVertexIndex(X, Y)];
+	const FVector& V10 = Vertices[GetVertexIndex(X + Size, Y)];
+	const FVector& V01 = Vertices[GetVertexIndex(X, Y + Size)];
+	const FVector& V11 = Vertices[GetVertexIndex(X + Size, Y + Size)];
+
+	float MaxErrorSquared = 0.f;
+	for(int32 y = 0; y <= Size; y++)
+	{
+		const float   V = static_cast<float>(y) / Size;
+		const FVector Left = FMath::Lerp(V00, V01, V);
+		const FVector Right = FMath::Lerp(V10, V11, V);
+		for(int32 x = 0; x <= Size; x++)
+		{
+			const FVector Expected = FMath::Lerp(Left, Right, static_cast<float>(x) / Size);
+			MaxErrorSquared = FMath::Max(MaxErrorSquared, static_cast<float>(FVector::DistSquared(Expected, Vertices[GetVertexIndex(X + x, Y + y)])));
+		}
+	}
+	return FMath::Sqrt(MaxErrorSquared);
+}
+
+void FTerrainQuadtreeMesh::SetLeaf(const int32 X, const int32 Y, const int32 Size)
+{
+	for(int32 y = Y; y < Y + Size; y++)
+	{
+		for(int32 x = X; x < X + Size; x++)
+		{
+			LeafSizes[x + y * NumOfXCells] = Size;
+		}
+	}
+}
+
+void FTerrainQuadtreeMesh::Refine(const int32 X, const int32 Y, const int32 Size)
+{
+	if(IsOutside(X, Y, Size))
+	{
+		return;
+	}
+	// nodes hanging over the edge of the grid are always split, their corners do not exist
+	if(Size == 1 || (IsInside(X, Y, Size) && GetError(X, Y, Size) <= Tolerance))
+	{
+		SetLeaf(X, Y, Size);
+		return;
+	}
+
+	const int32 HalfSize = Size / 2;
+	Refine(X, Y, HalfSize);
+	Refine(X + HalfSize, Y, HalfSize);
+	Refine(X, Y + HalfSize, HalfSize);
+	Refine(X + HalfSize, Y + HalfSize, HalfSize);
+}
+
+/**
+ * @return true if a leaf along any edge of the node is more than one level finer than the node
+ */
+bool FTerrainQuadtreeMesh::NeedsSplit(const int32 X, const int32 Y, const int32 Size) const
+{
+	const int32 MinNeighbourSize = Size / 2;
+	for(int32 i = 0; i < Size; i++)
+	{
+		if((X > 0 && GetLeafSize(X - 1, Y + i) < MinNeighbourSize)
+			|| (X + Size < NumOfXCells && GetLeafSize(X + Size, Y + i) < MinNeighbourSize)
+			|| (Y > 0 && GetLeafSize(X + i, Y - 1) < MinNeighbourSize)
+			|| (Y + Size < NumOfYCells && GetLeafSize(X + i, Y + Size) < MinNeighbourSize))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * @return true if the cell exists and belongs to a leaf smaller than Size
+ */
+bool FTerrainQuadtreeMesh::IsFinerAcross(const int32 CellX, const int32 CellY, const int32 Size) const
+{
+	return CellX >= 0 && CellY >= 0 && CellX < NumOfXCells && CellY < NumOfYCells && GetLeafSize(CellX, CellY) < Size;
+}
+
+/**
+ * Triangles of a single leaf. A cell is split like the full grid, anything larger is a fan around its centre.
+ */
+void FTerrainQuadtreeMesh::AddLeafTriangles(const int32 X, const int32 Y, const int32 Size, TArray<int32>& OutTriangles) const
+{
+	if(Size == 1)
+	{
+		OutTriangles.Add(GetVertexIndex(X, Y));
+		OutTriangles.Add(GetVertexIndex(X, Y + 1));
+		OutTriangles.Add(GetVertexIndex(X + 1, Y));
+
+		OutTriangles.Add(GetVertexIndex(X + 1, Y));
+		OutTriangles.Add(GetVertexIndex(X, Y + 1));
+		OutTriangles.Add(GetVertexIndex(X + 1, Y + 1));
+		return;
+	}
+
+	const int32 HalfSize = Size / 2;
+
+	// boundary in the same rotation as the full grid triangles, with the midpoints of the edges shared with finer leaves
+	TArray<int32, TInlineAllocator<8>> Boundary;
+	Boundary.Add(GetVertexIndex(X, Y));
+	if(IsFinerAcross(X - 1, Y, Size))
+	{
+		Boundary.Add(GetVertexIndex(X, Y + HalfSize));
+	}
+	Boundary.Add(GetVertexIndex(X, Y + Size));
+	if(IsFinerAcross(X, Y + Size, Size))
+	{
+		Boundary.Add(GetVertexIndex(X + HalfSize, Y + Size));
+	}
+	Boundary.Add(GetVertexIndex(X + Size, Y + Size));
+	if(IsFinerAcross(X + Size, Y, Size))
+	{
+		Boundary.Add(GetVertexIndex(X + Size, Y + HalfSize));
+	}
+	Boundary.Add(GetVertexIndex(X + Size, Y));
+	if(IsFinerAcross(X, Y - 1, Size))
+	{
+		Boundary.Add(GetVertexIndex(X + HalfSize, Y));
+	}
+
+	const int32 Centre = GetVertexIndex(X + HalfSize, Y + HalfSize);
+	for(int32 i = 0; i < Boundary.Num(); i++)
+	{
+		OutTriangles.Add(Centre);
+		OutTriangles.Add(Boundary[i]);
+		OutTriangles.Add(Boundary[(i + 1) % Boundary.Num()]);
+	}
+}
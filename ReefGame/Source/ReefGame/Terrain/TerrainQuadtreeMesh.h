@@ -0,0 +1,40 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Adaptive triangulation of the terrain grid with a restricted quadtree.
+ * A node is only split while the grid vertices inside it stray further than the tolerance from the surface spanned by its corners,
+ * so the flat sand collapses into a few large nodes and the vertex budget goes to the cliffs. Neighbouring leaves differ by at most one level
+ * and every leaf is drawn as a fan around its centre that picks up the midpoint of any edge shared with finer leaves, which leaves no cracks.
+ * Only grid vertices are used, so the result indexes straight into the full resolution vertex arrays.
+ */
+class REEFGAME_API FTerrainQuadtreeMesh {
+public:
+	FTerrainQuadtreeMesh(TArray<FVector> const& InVertices, int32 InNumOfXVertices, int32 InNumOfYVertices, float InTolerance);
+
+	bool Triangulate(TArray<int32>& OutTriangles, TFunctionRef<bool()> IsCancelled);
+
+private:
+	TArray<FVector> const& Vertices;
+	const int32            NumOfXVertices;
+	const int32            NumOfYVertices;
+	const int32            NumOfXCells;
+	const int32            NumOfYCells;
+	const float            Tolerance;
+
+	// Size of the leaf covering each cell, leaves are aligned to their size
+	TArray<int32> LeafSizes;
+
+	int32 GetVertexIndex(const int32 X, const int32 Y) const { return X + Y * NumOfXVertices; }
+	int32 GetLeafSize(const int32 CellX, const int32 CellY) const { return LeafSizes[CellX + CellY * NumOfXCells]; }
+
+	bool  IsInside(int32 X, int32 Y, int32 Size) const;
+	bool  IsOutside(int32 X, int32 Y, int32 Size) const;
+	float GetError(int32 X, int32 Y, int32 Size) const;
+	void  SetLeaf(int32 X, int32 Y, int32 Size);
+	void  Refine(int32 X, int32 Y, int32 Size);
+	bool  NeedsSplit(int32 X, int32 Y, int32 Size) const;
+	bool  IsFinerAcross(int32 CellX, int32 CellY, int32 Size) const;
+	void  AddLeafTriangles(int32 X, int32 Y, int32 Size, TArray<int32>& OutTriangles) const;
+};
@@ -0,0 +1,256 @@
+#include "TerrainQuerySubsystem.h"
+#include "TerrainHeightfield.h"
+
+// Setters
+
+/**
+ * Set the heightfield the queries are answered from.
+ *
+ * @param NewHeightfield  The baked terrain
+ * @param NewTerrainTransform  The transform of the terrain in the world
+ */
+/**
+ * Answer the queries from a heightfield from now on.
+ *
+ * @param NewHeightfield  The baked heightfield, null to answer nothing.
+ * @param NewTerrainTransform  Terrain space to world space.
+ * @param NewTerrainActor  The terrain the heightfield was baked from, traces can ignore it once the heightfield has been checked.
+ */
+void UTerrainQuerySubsystem::SetHeightfield(UTerrainHeightfield* NewHeightfield, FTransform const& NewTerrainTransform, AActor* NewTerrainActor)
+{
+	if(NewHeightfield && !NewHeightfield->IsValidHeightfield())
+	{
+		UE_LOG(LogTemp, Error, TEXT("TerrainQuery: Heightfield %s has not been baked"), *NewHeightfield->GetName());
+		NewHeightfield = nullptr;
+	}
+	Heightfield = NewHeightfield;
+	TerrainTransform = NewTerrainTransform;
+	TerrainActor = NewTerrainActor;
+
+	HeightPyramid.Reset();
+	if(Heightfield)
+	{
+		HeightPyramid.Build(Heightfield->NumOfXVertices, Heightfield->NumOfYVertices,
+		                    [this](const int32 Index) { return FVector(Heightfield->Vertices[Index]); });
+	}
+}
+
+/**
+ * @return true if there is a heightfield to answer queries from
+ */
+bool UTerrainQuerySubsystem::IsOk() const
+{
+	return Heightfield != nullptr;
+}
+
+// Grid queries
+
+/**
+ * Gets the position of the terrain in terrain space at the given grid coordinates.
+ *
+ * @param X The X coordinate in vertices.
+ * @param Y The Y coordinate in vertices.
+ * @return The position, or FVector::ZeroVector if there is no heightfield or the coordinates are outside of it.
+ */
+FVector UTerrainQuerySubsystem::GetVertexPosition(const float X, const float Y) const
+{
+	FTerrainGridCell Cell;
+	if(!Heightfield || !FTerrainGridCell::Find(X, Y, Heightfield->NumOfXVertices, Heightfield->NumOfYVertices, Cell))
+	{
+		return FVector::ZeroVector;
+	}
+
+	return FVector(Cell.Interpolate(Heightfield->Vertices));
+}
+
+/**
+ * Gets the normal of the terrain in terrain space at the given grid coordinates.
+ *
+ * @param X The X coordinate in vertices.
+ * @param Y The Y coordinate in vertices.
+ * @return The normal, or FVector::ZeroVector if there is no heightfield or the coordinates are outside of it.
+ */
+FVector UTerrainQuerySubsystem::GetNormal(const float X, const float Y) const
+{
+	FTerrainGridCell Cell;
+	if(!Heightfield || !FTerrainGridCell::Find(X, Y, Heightfield->NumOfXVertices, Heightfield->NumOfYVertices, Cell))
+	{
+		return FVector::ZeroVector;
+	}
+
+	return FVector(Cell.Interpolate(Heightfield->Normals)).GetSafeNormal();
+}
+
+/**
+ *  The depth percentage at the given grid coordinates, 1.0 at the lowest point of the terrain and 0.0 at the highest.
+ *
+ * @param X The X coordinate in vertices.
+ * @param Y The Y coordinate in vertices.
+ * @return The depth percentage, or 0.f if there is no heightfield or the coordinates are outside of it.
+ */
+float UTerrainQuerySubsystem::GetDepthPercentage(const float X, const float Y) const
+{
+	FTerrainGridCell Cell;
+	if(!Heightfield || !FTerrainGridCell::Find(X, Y, Heightfield->NumOfXVertices, Heightfield->NumOfYVertices, Cell))
+	{
+		return 0.f;
+	}
+
+	const float HeightRange = Heightfield->Bounds.Max.Z - Heightfield->Bounds.Min.Z;
+	if(HeightRange > SMALL_NUMBER)
+	{
+		return 1.f - ((Cell.Interpolate(Heightfield->Vertices).Z - Heightfield->Bounds.Min.Z) / HeightRange);
+	}
+
+	return 0.f;
+}
+
+/**
+ * Position, normal and depth percentage at the given grid coordinates in a single fetch.
+ *
+ * @param X The X coordinate in vertices.
+ * @param Y The Y coordinate in vertices.
+ * @return The sample, invalid and zeroed if there is no heightfield or the coordinates are outside of it.
+ */
+FTerrainSample UTerrainQuerySubsystem::SampleTerrain(const float X, const float Y) const
+{
+	FTerrainGridCell Cell;
+	if(!Heightfield || !FTerrainGridCell::Find(X, Y, Heightfield->NumOfXVertices, Heightfield->NumOfYVertices, Cell))
+	{
+		return FTerrainSample();
+	}
+	return Cell.Sample(Heightfield->Vertices, Heightfield->Normals, Heightfield->Bounds.Min.Z, Heightfield->Bounds.Max.Z);
+}
+
+/**
+ * Batched SampleTerrain.
+ *
+ * @param Points  The coordinates to sample, X and Y in vertices.
+ * @param OutSamples  One sample per point, in the same order.
+ */
+void UTerrainQuerySubsystem::SampleTerrain(TArrayView<const FVector2D> Points, TArray<FTerrainSample>& OutSamples) const
+{
+	OutSamples.Reset(Points.Num());
+	for(const FVector2D& Point : Points)
+	{
+		OutSamples.Add(SampleTerrain(Point.X, Point.Y));
+	}
+}
+
+/**
+ * @return The bounding box of the terrain in terrain space
+ */
+FBox UTerrainQuerySubsystem::GetBoundingBox() const
+{
+	return Heightfield ? Heightfield->Bounds : FBox(ForceInit);
+}
+
+/**
+ * Convert a world location to grid coordinates.
+ * The grid is regular before the cliffs displace it, so this is exact on the sand and approximate on the cliff faces.
+ *
+ * @param WorldLocation  The location in the world
+ * @return The coordinates in vertices
+ */
+FVector2D UTerrainQuerySubsystem::GetGridCoordinates(FVector const& WorldLocation) const
+{
+	if(!Heightfield)
+	{
+		return FVector2D::ZeroVector;
+	}
+	const FVector Local = TerrainTransform.InverseTransformPosition(WorldLocation);
+	return FVector2D(Local.X, Local.Y) * Heightfield->Density;
+}
+
+// World queries
+
+/**
+ * Find where a segment first hits the terrain, without going through physics.
+ *
+ * @param WorldStart  The start of the segment in the world
+ * @param WorldEnd  The end of the segment in the world
+ * @param OutHit  The closest hit in world space, only set if there is one
+ * @return true if the segment hits the terrain
+ */
+bool UTerrainQuerySubsystem::RaycastTerrain(FVector const& WorldStart, FVector const& WorldEnd, FTerrainRayHit& OutHit) const
+{
+	if(!Heightfield)
+	{
+		return false;
+	}
+
+	FTerrainRayHit LocalHit;
+	if(!HeightPyramid.Raycast(TerrainTransform.InverseTransformPosition(WorldStart), TerrainTransform.InverseTransformPosition(WorldEnd),
+	                          [this](const int32 Index) { return FVector(Heightfield->Vertices[Index]); }, LocalHit))
+	{
+		return false;
+	}
+
+	OutHit.Time = LocalHit.Time;
+	OutHit.Location = TerrainTransform.TransformPosition(LocalHit.Location);
+	OutHit.Normal = TerrainTransform.TransformVectorNoScale(LocalHit.Normal);
+	return true;
+}
+
+/**
+ * Check whether a sphere touches the terrain, without going through physics.
+ *
+ * @param WorldCentre  The centre of the sphere in the world
+ * @param Radius  The radius of the sphere in world units
+ * @return true if the sphere touches the terrain
+ */
+bool UTerrainQuerySubsystem::SphereOverlapsTerrain(FVector const& WorldCentre, const float Radius) const
+{
+	if(!Heightfield)
+	{
+		return false;
+	}
+
+	const float Scale = TerrainTransform.GetMinimumAxisScale();
+	if(Scale <= SMALL_NUMBER)
+	{
+		return false;
+	}
+	return HeightPyramid.SphereOverlaps(TerrainTransform.InverseTransformPosition(WorldCentre), Radius / Scale,
+	                                    [this](const int32 Index) { return FVector(Heightfield->Vertices[Index]); });
+}
+
+/**
+ * @param WorldLocation  The location in the world, only X and Y are used
+ * @return The point of the terrain under (or over) the location in world space, or the location itself outside of the terrain
+ */
+FVector UTerrainQuerySubsystem::GetTerrainLocationAt(FVector const& WorldLocation) const
+{
+	const FVector2D Grid = GetGridCoordinates(WorldLocation);
+	FTerrainGridCell Cell;
+	if(!Heightfield || !FTerrainGridCell::Find(Grid.X, Grid.Y, Heightfield->NumOfXVertices, Heightfield->NumOfYVertices, Cell))
+	{
+		return WorldLocation;
+	}
+	return TerrainTransform.TransformPosition(FVector(Cell.Interpolate(Heightfield->Vertices)));
+}
+
+/**
+ * @param WorldLocation  The location in the world, only X and Y are used
+ * @return The normal of the terrain under (or over) the location in world space, or FVector::UpVector outside of the terrain
+ */
+FVector UTerrainQuerySubsystem::GetTerrainNormalAt(FVector const& WorldLocation) const
+{
+	const FVector2D Grid = GetGridCoordinates(WorldLocation);
+	const FVector   Normal = GetNormal(Grid.X, Grid.Y);
+	if(Normal.IsZero())
+	{
+		return FVector::UpVector;
+	}
+	return TerrainTransform.TransformVectorNoScale(Normal);
+}
+
+/**
+ * @param WorldLocation  The location in the world, only X and Y are used
+ * @return The depth percentage of the terrain under (or over) the location
+ */
+float UTerrainQuerySubsystem::GetDepthPercentageAt(FVector const& WorldLocation) const
+{
+	const FVector2D Grid = GetGridCoordinates(WorldLocation);
+	return GetDepthPercentage(Grid.X, Grid.Y);
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "TerrainGridCell.h"
+#include "TerrainHeightPyramid.h"
+#include "TerrainQuerySubsystem.generated.h"
+
+class UTerrainHeightfield;
+
+/**
+ * Runtime terrain queries for gameplay (fish depth preference, spawner placement, obstacle avoidance).
+ * Answers the same bilinear height, normal and depth queries as the editor terrain manager from a baked UTerrainHeightfield,
+ * so it works in cooked games and on dedicated servers without tracing against the procedural mesh.
+ * Grid queries take coordinates in vertices, the *AtLocation variants and the ray and sphere queries take world locations.
+ */
+UCLASS()
+class REEFGAME_API UTerrainQuerySubsystem : public UWorldSubsystem {
+	GENERATED_BODY()
+
+	UPROPERTY()
+	UTerrainHeightfield* Heightfield;
+
+	// Terrain space to world space
+	FTransform TerrainTransform;
+
+	// The actor whose collision the heightfield stands in for
+	TWeakObjectPtr<AActor> TerrainActor;
+
+	// Bounds hierarchy over the heightfield vertices for ray and sphere queries
+	FTerrainHeightPyramid HeightPyramid;
+
+public:
+	void    SetHeightfield(UTerrainHeightfield* NewHeightfield, FTransform const& NewTerrainTransform, AActor* NewTerrainActor = nullptr);
+	bool    IsOk() const;
+	AActor* GetTerrainActor() const { return TerrainActor.Get(); }
+
+	FVector   GetVertexPosition(float X, float Y) const;
+	FVector   GetNormal(float X, float Y) const;
+	float     GetDepthPercentage(float X, float Y) const;
+	FTerrainSample SampleTerrain(float X, float Y) const;
+	void      SampleTerrain(TArrayView<const FVector2D> Points, TArray<FTerrainSample>& OutSamples) const;
+	FBox      GetBoundingBox() const;
+	FVector2D GetGridCoordinates(FVector const& WorldLocation) const;
+	bool      RaycastTerrain(FVector const& WorldStart, FVector const& WorldEnd, FTerrainRayHit& OutHit) const;
+	bool      SphereOverlapsTerrain(FVector const& WorldCentre, float Radius) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Terrain")
+	FVector GetTerrainLocationAt(FVector const& WorldLocation) const;
+	UFUNCTION(BlueprintCallable, Category = "Terrain")
+	FVector GetTerrainNormalAt(FVector const& WorldLocation) const;
+	UFUNCTION(BlueprintCallable, Category = "Terrain")
+	float GetDepthPercentageAt(FVector const& WorldLocation) const;
+};
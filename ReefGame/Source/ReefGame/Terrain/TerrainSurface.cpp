@@ -0,0 +1,154 @@
+#include "TerrainSurface.h"
+
+/**
+ * Replace the surface with the given mesh data.
+ *
+ * @param Vertices  The vertices of the terrain grid, row by row.
+ * @param Normals  The normals of the vertices.
+ * @param NewNumOfXVertices  The width of the grid.
+ * @param NewNumOfYVertices  The height of the grid.
+ * @param NewDensity  The vertices per unit the grid was generated with.
+ */
+void FTerrainSurface::Compact(TArray<FVector> const& Vertices, TArray<FVector> const& Normals, const int32 NewNumOfXVertices,
+                              const int32 NewNumOfYVertices, const float NewDensity)
+{
+	const int32 NumOfVertices = NewNumOfXVertices * NewNumOfYVertices;
+	if(Vertices.Num() != NumOfVertices || Normals.Num() != NumOfVertices)
+	{
+		UE_LOG(LogTemp, Error, TEXT("TerrainSurface: Mesh data does not match a %dx%d grid"), NewNumOfXVertices, NewNumOfYVertices);
+		Reset();
+		return;
+	}
+
+	Init(NewNumOfXVertices, NewNumOfYVertices, NewDensity);
+	CompactRows(0, NumOfYVertices, Vertices, Normals);
+}
+
+/**
+ * Size the surface for a grid, the rows are filled in by CompactRows.
+ *
+ * @param NewNumOfXVertices  The width of the grid.
+ * @param NewNumOfYVertices  The height of the grid.
+ * @param NewDensity  The vertices per unit the grid was generated with.
+ */
+void FTerrainSurface::Init(const int32 NewNumOfXVertices, const int32 NewNumOfYVertices, const float NewDensity)
+{
+	if(NewDensity <= 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("TerrainSurface: Invalid density %f"), NewDensity);
+		Reset();
+		return;
+	}
+
+	NumOfXVertices = NewNumOfXVertices;
+	NumOfYVertices = NewNumOfYVertices;
+	Density = NewDensity;
+
+	const int32 NumOfVertices = NumOfXVertices * NumOfYVertices;
+	Heights.SetNumUninitialized(NumOfVertices);
+	Displacements.SetNumUninitialized(NumOfVertices);
+	PackedNormals.SetNumUninitialized(NumOfVertices);
+}
+
+/**
+ * Compact a range of rows of the mesh data, the rows of the full precision arrays have to be final.
+ *
+ * @param RowBegin  The first row.
+ * @param RowEnd  One past the last row.
+ * @param Vertices  The vertices of the whole terrain grid, row by row.
+ * @param Normals  The normals of the vertices.
+ */
+void FTerrainSurface::CompactRows(const int32 RowBegin, const int32 RowEnd, TArray<FVector> const& Vertices, TArray<FVector> const& Normals)
+{
+	for(int32 i = RowBegin * NumOfXVertices; i < RowEnd * NumOfXVertices && i < Num(); i++)
+	{
+		const FVector Displacement = Vertices[i] - GetGridPosition(i);
+		Heights[i] = Vertices[i].Z;
+		Displacements[i] = FVector2f(Displacement.X, Displacement.Y);
+		PackedNormals[i] = PackNormal(Normals[i]);
+	}
+}
+
+void FTerrainSurface::Reset()
+{
+	NumOfXVertices = 0;
+	NumOfYVertices = 0;
+	Heights.Empty();
+	Displacements.Empty();
+	PackedNormals.Empty();
+}
+
+/**
+ * @param OutVertices  Every vertex of the surface in full precision, for the mesh hand-off.
+ */
+void FTerrainSurface::ExpandVertices(TArray<FVector>& OutVertices) const
+{
+	OutVertices.SetNumUninitialized(Num());
+	for(int32 i = 0; i < Num(); i++)
+	{
+		OutVertices[i] = GetVertex(i);
+	}
+}
+
+/**
+ * @param OutNormals  Every normal of the surface, for the mesh hand-off.
+ */
+void FTerrainSurface::ExpandNormals(TArray<FVector>& OutNormals) const
+{
+	OutNormals.SetNumUninitialized(Num());
+	for(int32 i = 0; i < Num(); i++)
+	{
+		OutNormals[i] = GetNormal(i);
+	}
+}
+
+SIZE_T FTerrainSurface::GetAllocatedSize() const
+{
+	return Heights.GetAllocatedSize() + Displacements.GetAllocatedSize() + PackedNormals.GetAllocatedSize();
+}
+
+/**
+ * Octahedral encoding: project the normal on the octahedron, fold the lower half over the upper one
+ * and quantise the resulting square to 16 bits per axis.
+ *
+ * @param Normal  The normal to pack, does not need to be normalised.
+ * @return X in the low 16 bits, Y in the high 16 bits.
+ */
+uint32 FTerrainSurface::PackNormal(FVector const& Normal)
+{
+	const double L1 = FMath::Abs(Normal.X) + FMath::Abs(Normal.Y) + FMath::Abs(Normal.Z);
+	if(L1 <= UE_DOUBLE_SMALL_NUMBER)
+	{
+		return PackNormal(FVector::UpVector);
+	}
+
+	double X = Normal.X / L1;
+	double Y = Normal.Y / L1;
+	if(Normal.Z < 0)
+	{
+		const double FoldedX = (1.0 - FMath::Abs(Y)) * (X >= 0 ? 1.0 : -1.0);
+		const double FoldedY = (1.0 - FMath::Abs(X)) * (Y >= 0 ? 1.0 : -1.0);
+		X = FoldedX;
+		Y = FoldedY;
+	}
+
+	const uint32 PackedX = FMath::RoundToInt32((X * 0.5 + 0.5) * MAX_uint16);
+	const uint32 PackedY = FMath::RoundToInt32((Y * 0.5 + 0.5) * MAX_uint16);
+	return PackedX | PackedY << 16;
+}
+
+/**
+ * @param Packed  A normal packed by PackNormal.
+ * @return The unit normal.
+ */
+FVector FTerrainSurface::UnpackNormal(const uint32 Packed)
+{
+	const double X = (Packed & MAX_uint16) / static_cast<double>(MAX_uint16) * 2.0 - 1.0;
+	const double Y = (Packed >> 16) / static_cast<double>(MAX_uint16) * 2.0 - 1.0;
+
+	FVector      Normal(X, Y, 1.0 - FMath::Abs(X) - FMath::Abs(Y));
+	const double Fold = FMath::Max(-Normal.Z, 0.0);
+	Normal.X += Normal.X >= 0 ? -Fold : Fold;
+	Normal.Y += Normal.Y >= 0 ? -Fold : Fold;
+	return Normal.GetSafeNormal();
+}
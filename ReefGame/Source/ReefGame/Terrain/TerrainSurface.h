@@ -0,0 +1,58 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Compact copy of the generated terrain surface, what the terrain manager keeps between generations for its queries.
+ * The grid is regular before the cliffs push it around, so a vertex is stored as its height plus its XY displacement
+ * from the grid position, in single precision. Normals are octahedral packed into 16 bits per axis, UVs are the grid
+ * coordinates and are not stored at all. That is 16 bytes per vertex against well over 100 for the full mesh arrays,
+ * which are only expanded again for the procedural mesh hand-off.
+ */
+struct REEFGAME_API FTerrainSurface {
+	int32 NumOfXVertices = 0;
+	int32 NumOfYVertices = 0;
+	// Vertices per unit of the grid
+	float Density = 1.f;
+
+	TArray<float>    Heights;
+	TArray<FVector2f> Displacements;
+	TArray<uint32>   PackedNormals;
+
+	void Compact(TArray<FVector> const& Vertices, TArray<FVector> const& Normals, int32 NewNumOfXVertices, int32 NewNumOfYVertices,
+	             float NewDensity);
+	void Init(int32 NewNumOfXVertices, int32 NewNumOfYVertices, float NewDensity);
+	void CompactRows(int32 RowBegin, int32 RowEnd, TArray<FVector> const& Vertices, TArray<FVector> const& Normals);
+	void Reset();
+	bool IsEmpty() const { return Heights.Num() == 0; }
+	int32 Num() const { return Heights.Num(); }
+
+	FVector GetGridPosition(const int32 Index) const
+	{
+		return FVector((Index % NumOfXVertices) / Density, (Index / NumOfXVertices) / Density, 0);
+	}
+
+	FVector GetVertex(const int32 Index) const
+	{
+		const FVector2f& Displacement = Displacements[Index];
+		return GetGridPosition(Index) + FVector(Displacement.X, Displacement.Y, Heights[Index]);
+	}
+
+	FVector GetNormal(const int32 Index) const
+	{
+		return UnpackNormal(PackedNormals[Index]);
+	}
+
+	FVector2D GetUV(const int32 Index) const
+	{
+		return FVector2D(Index % NumOfXVertices, Index / NumOfXVertices);
+	}
+
+	void ExpandVertices(TArray<FVector>& OutVertices) const;
+	void ExpandNormals(TArray<FVector>& OutNormals) const;
+
+	SIZE_T GetAllocatedSize() const;
+
+	static uint32  PackNormal(FVector const& Normal);
+	static FVector UnpackNormal(uint32 Packed);
+};
@@ -10,6 +10,6 @@ public class ReefGameEditorTarget : TargetRules
 		Type = TargetType.Editor;
 		DefaultBuildSettings = BuildSettingsVersion.V2;
 		IncludeOrderVersion = EngineIncludeOrderVersion.Unreal5_1;
-		ExtraModuleNames.Add("ReefGame");
+		ExtraModuleNames.AddRange(new string[] { "ReefGame", "ReefGameEditor" });
 	}
 }
@@ -0,0 +1,42 @@
+#include "DiskCache.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+void DiskCache::Touch(FString const& FilePath)
+{
+	IFileManager::Get().SetTimeStamp(*FilePath, FDateTime::UtcNow());
+}
+
+void DiskCache::Prune(FString const& Directory, FString const& Extension, const int64 MaxBytes)
+{
+	struct FEntry {
+		FString   Path;
+		FDateTime LastUsed;
+		int64     Size = 0;
+	};
+
+	TArray<FEntry> Entries;
+	IFileManager::Get().IterateDirectoryStat(*Directory, [&Entries, &Extension](const TCHAR* Path, FFileStatData const& Stat)
+	{
+		if(!Stat.bIsDirectory && FPaths::GetExtension(Path, true) == Extension)
+		{
+			Entries.Add({Path, Stat.ModificationTime, Stat.FileSize});
+		}
+		return true;
+	});
+
+	// most recently used first, whatever no longer fits after them is deleted
+	Entries.Sort([](FEntry const& A, FEntry const& B) { return A.LastUsed > B.LastUsed; });
+	int64 Total = 0;
+	for(const FEntry& Entry : Entries)
+	{
+		Total += Entry.Size;
+		if(Total > MaxBytes)
+		{
+			if(IFileManager::Get().Delete(*Entry.Path, false, false, true))
+			{
+				UE_LOG(LogTemp, Log, TEXT("Pruned cache entry %s"), *Entry.Path);
+			}
+		}
+	}
+}
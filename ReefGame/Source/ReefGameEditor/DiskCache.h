@@ -0,0 +1,26 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * The terrains and placements kept in Saved so that generating the same environment again is a single file read.
+ * An entry is touched whenever it is read, once a directory grows past its cap the least recently used entries go.
+ */
+namespace DiskCache
+{
+	/**
+	 * Mark an entry as just used, so it is the last one to be pruned.
+	 *
+	 * @param FilePath  The entry.
+	 */
+	void Touch(FString const& FilePath);
+
+	/**
+	 * Delete the least recently used entries of a directory until the rest fits in MaxBytes.
+	 *
+	 * @param Directory  The cache directory.
+	 * @param Extension  The extension of the entries, with the dot, other files are left alone.
+	 * @param MaxBytes  How much the entries may take up together.
+	 */
+	void Prune(FString const& Directory, FString const& Extension, int64 MaxBytes);
+}
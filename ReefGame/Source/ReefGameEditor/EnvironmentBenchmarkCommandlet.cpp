@@ -0,0 +1,217 @@
+#include "EnvironmentBenchmarkCommandlet.h"
+#include "Editor.h"
+#include "EngineUtils.h"
+#include "EnvironmentEditorActions.h"
+#include "ReefGame/Environment.h"
+#include "Flora/FixedBeingsManagerEditorSubsystem.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "ProfilingDebugging/ScopedTimers.h"
+#include "ReefGame/Terrain/Terrain.h"
+#include "Terrain/TerrainManagerEditorSubsystem.h"
+
+namespace
+{
+	/**
+	 * Parse a comma separated list of values, or fall back to a single value.
+	 *
+	 * @param ParamsMap  The parsed command line.
+	 * @param Key  The parameter to look for.
+	 * @param Default  The value if the parameter is not there.
+	 * @return The values, never empty.
+	 */
+	template <typename T>
+	TArray<T> ParseValues(TMap<FString, FString> const& ParamsMap, const TCHAR* Key, T Default)
+	{
+		TArray<T> Values;
+		if(const FString* List = ParamsMap.Find(Key))
+		{
+			TArray<FString> Items;
+			List->ParseIntoArray(Items, TEXT(","));
+			for(FString const& Item : Items)
+			{
+				T Value = Default;
+				LexFromString(Value, *Item.TrimStartAndEnd());
+				Values.Add(Value);
+			}
+		}
+		if(Values.Num() == 0)
+		{
+			Values.Add(Default);
+		}
+		return Values;
+	}
+
+	UWorld* LoadTemplateWorld(FString const& MapName)
+	{
+		UPackage* Package = LoadPackage(nullptr, *MapName, LOAD_None);
+		UWorld*   World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+		if(!World)
+		{
+			return nullptr;
+		}
+
+		World->AddToRoot();
+		World->WorldType = EWorldType::Editor;
+		if(!World->bIsWorldInitialized)
+		{
+			World->InitWorld(UWorld::InitializationValues()
+			                 .AllowAudioPlayback(false)
+			                 .CreateNavigation(false)
+			                 .CreateAISystem(false)
+			                 .ShouldSimulatePhysics(false));
+		}
+		World->UpdateWorldComponents(true, false);
+		return World;
+	}
+}
+
+UEnvironmentBenchmarkCommandlet::UEnvironmentBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+	HelpDescription = TEXT("Times the terrain generation and the fixed beings placement of a level over a matrix of parameters");
+	HelpUsage = TEXT("-run=EnvironmentBenchmark -Map=<level> [-Density=a,b] [-Passes=a,b] [-ClusterRange=a,b] [-Repeats=n] [-Output=<csv>]");
+}
+
+int32 UEnvironmentBenchmarkCommandlet::Main(const FString& Params)
+{
+	TArray<FString>        Tokens;
+	TArray<FString>        Switches;
+	TMap<FString, FString> ParamsMap;
+	ParseCommandLine(*Params, Tokens, Switches, ParamsMap);
+
+	const FString* MapName = ParamsMap.Find(TEXT("Map"));
+	if(!MapName || !GEditor)
+	{
+		UE_LOG(LogTemp, Error, TEXT("EnvironmentBenchmark: %s"), *HelpUsage);
+		return 1;
+	}
+
+	auto const TerrainManager = GEditor->GetEditorSubsystem<UTerrainManagerEditorSubsystem>();
+	auto const FBManager = GEditor->GetEditorSubsystem<UFixedBeingsManagerEditorSubsystem>();
+	if(!TerrainManager || !FBManager)
+	{
+		UE_LOG(LogTemp, Error, TEXT("EnvironmentBenchmark: the terrain and fixed beings managers are not available"));
+		return 1;
+	}
+
+	UWorld* World = LoadTemplateWorld(*MapName);
+	if(!World)
+	{
+		UE_LOG(LogTemp, Error, TEXT("EnvironmentBenchmark: failed to load %s"), **MapName);
+		return 1;
+	}
+
+	// the managers spawn into the editor world
+	FWorldContext& Context = GEditor->GetEditorWorldContext();
+	UWorld*        PreviousWorld = Context.World();
+	Context.SetCurrentWorld(World);
+
+	AEnvironment* Environment = nullptr;
+	for(TActorIterator<AEnvironment> It(World); It; ++It)
+	{
+		Environment = *It;
+		break;
+	}
+	if(!Environment || !Environment->TerrainMaterial || !Environment->CliffCurve)
+	{
+		UE_LOG(LogTemp, Error, TEXT("EnvironmentBenchmark: %s has no environment with a terrain material and a cliff curve"), **MapName);
+		Context.SetCurrentWorld(PreviousWorld);
+		World->RemoveFromRoot();
+		return 1;
+	}
+
+	const TArray<float> Densities = ParseValues(ParamsMap, TEXT("Density"), Environment->Density);
+	const TArray<int32> Passes = ParseValues(ParamsMap, TEXT("Passes"), Environment->FixedBeingPlacingPasses);
+	const TArray<float> ClusterRanges = ParseValues(ParamsMap, TEXT("ClusterRange"), Environment->ClusterRange);
+	const int32         Repeats = FMath::Max(ParseValues(ParamsMap, TEXT("Repeats"), 1)[0], 1);
+
+	const FString* OutputParam = ParamsMap.Find(TEXT("Output"));
+	const FString  Output = OutputParam
+		                       ? *OutputParam
+		                       : FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Benchmarks"),
+		                                         FString::Printf(TEXT("EnvironmentBenchmark-%s.csv"), *FDateTime::Now().ToString()));
+
+	// every run generates from scratch
+	TerrainManager->bUseDiskCache = false;
+	FBManager->bUseDiskCache = false;
+
+	FString Csv = TEXT("Run,Density,Passes,ClusterRange,Vertices,VerticesSeconds,TrianglesSeconds,TangentsSeconds,CollisionSeconds,SimplifySeconds,")
+		TEXT("MeshSeconds,PlacementSeconds,SlowestPassSeconds,ReconciliationSeconds,BeingsPlaced,UsedPhysicalMB,PeakUsedPhysicalMB\n");
+
+	int32 Run = 0;
+	for(const float Density : Densities)
+	{
+		for(const int32 NumOfPasses : Passes)
+		{
+			for(const float Range : ClusterRanges)
+			{
+				for(int32 Repeat = 0; Repeat < Repeats; Repeat++, Run++)
+				{
+					Environment->Density = Density;
+					Environment->FixedBeingPlacingPasses = NumOfPasses;
+					Environment->ClusterRange = Range;
+
+					// the whole terrain is rebuilt, not only the stages the parameters touch
+					TerrainManager->bDirty = true;
+					TerrainManager->CheckChildren(Environment);
+					ATerrain* Terrain = TerrainManager->GetTerrain(FEnvironmentEditorActions::GetTerrainParams(*Environment), Environment->TerrainMaterial, Environment->CliffCurve);
+					if(!Terrain)
+					{
+						UE_LOG(LogTemp, Error, TEXT("EnvironmentBenchmark: run %d failed to generate the terrain"), Run);
+						continue;
+					}
+					Environment->TerrainActor = Terrain;
+					Terrain->AttachToActor(Environment, FAttachmentTransformRules::KeepRelativeTransform);
+					const FTerrainBuildTimings Timings = TerrainManager->GetLastBuildTimings();
+
+					FBManager->CheckChildren(Environment);
+					FBManager->RedistributeFixedBeings(FEnvironmentEditorActions::GetFixedBeingsParams(*Environment), Environment, Environment->FixedBeingsClasses);
+
+					double PlacementSeconds = 0.0;
+					double SlowestPassSeconds = 0.0;
+					for(const double PassSeconds : FBManager->GetPassTimings())
+					{
+						PlacementSeconds += PassSeconds;
+						SlowestPassSeconds = FMath::Max(SlowestPassSeconds, PassSeconds);
+					}
+
+					// what every construction script run of a populated environment pays
+					double ReconciliationSeconds = 0.0;
+					{
+						FScopedDurationTimer Timer(ReconciliationSeconds);
+						FBManager->CheckChildren(Environment);
+					}
+
+					const FPlatformMemoryStats Memory = FPlatformMemory::GetStats();
+					const int64                NumOfVertices = static_cast<int64>(TerrainManager->NumOfXVertices) * TerrainManager->NumOfYVertices;
+					Csv += FString::Printf(TEXT("%d,%g,%d,%g,%lld,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%d,%.1f,%.1f\n"),
+					                       Run, Density, NumOfPasses, Range, NumOfVertices,
+					                       Timings.Vertices, Timings.Triangles, Timings.Tangents, Timings.Collision, Timings.Simplify, Timings.Mesh,
+					                       PlacementSeconds, SlowestPassSeconds, ReconciliationSeconds, FBManager->GetNumOfPlaced(),
+					                       Memory.UsedPhysical / (1024.0 * 1024.0), Memory.PeakUsedPhysical / (1024.0 * 1024.0));
+
+					UE_LOG(LogTemp, Display, TEXT("EnvironmentBenchmark: run %d, density %g, %d passes, cluster range %g: %lld vertices, %d beings"),
+					       Run, Density, NumOfPasses, Range, NumOfVertices, FBManager->GetNumOfPlaced());
+				}
+			}
+		}
+	}
+
+	FBManager->ClearAll();
+	Context.SetCurrentWorld(PreviousWorld);
+	World->RemoveFromRoot();
+
+	if(!FFileHelper::SaveStringToFile(Csv, *Output))
+	{
+		UE_LOG(LogTemp, Error, TEXT("EnvironmentBenchmark: failed to write %s"), *Output);
+		return 1;
+	}
+	UE_LOG(LogTemp, Display, TEXT("EnvironmentBenchmark: wrote %d runs to %s"), Run, *Output);
+	return 0;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "EnvironmentBenchmarkCommandlet.generated.h"
+
+/**
+ * Generates the environment of a template level for every combination of Density, FixedBeingPlacingPasses and ClusterRange
+ * and writes the time of every stage, the memory, the number of vertices and the number of beings placed to a CSV file.
+ * The disk caches are off so every run generates from scratch, the level is never saved.
+ *
+ * UnrealEditor-Cmd ReefGame.uproject -run=EnvironmentBenchmark -Map=/Game/Maps/Reef -Density=0.002,0.004 -Passes=10,100
+ *     -ClusterRange=500,1000 [-Repeats=3] [-Output=Benchmark.csv] -nullrhi -unattended
+ *
+ * A parameter that is left out keeps the value of the environment in the level.
+ */
+UCLASS()
+class UEnvironmentBenchmarkCommandlet : public UCommandlet {
+	GENERATED_BODY()
+
+public:
+	UEnvironmentBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
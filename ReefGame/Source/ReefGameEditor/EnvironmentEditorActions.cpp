@@ -0,0 +1,313 @@
+#include "EnvironmentEditorActions.h"
+#include "Editor.h"
+#include "Async/Async.h"
+#include "ScopedTransaction.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "UObject/Package.h"
+#include "ReefGame/Environment.h"
+#include "ReefGame/ScopedBulkEdit.h"
+#include "ReefGame/Flora/FixedBeingsSnapshot.h"
+#include "ReefGame/Terrain/Terrain.h"
+#include "ReefGame/Terrain/TerrainHeightfield.h"
+#include "Flora/FixedBeingsManagerEditorSubsystem.h"
+#include "Terrain/TerrainManagerEditorSubsystem.h"
+
+void FEnvironmentEditorActions::OnConstruction(AEnvironment& Environment)
+{
+	if(auto const FBManager = GEditor->GetEditorSubsystem<UFixedBeingsManagerEditorSubsystem>())
+	{
+		FBManager->RequestCheckChildren(&Environment);
+	}
+	if(auto const TManager = GEditor->GetEditorSubsystem<UTerrainManagerEditorSubsystem>())
+	{
+		if(!TManager->IsOk())
+		{
+			TManager->SetMaterial(Environment.TerrainMaterial);
+			TManager->SetCliffCurve(Environment.CliffCurve);
+		}
+		TManager->CheckChildren(&Environment);
+	}
+}
+
+
+// TERRAIN STUFF
+
+FTerrainParameters FEnvironmentEditorActions::GetTerrainParams(AEnvironment const& Environment)
+{
+	return FTerrainParameters(
+		{
+			Environment.Width,
+			Environment.Height,
+			Environment.Density,
+			Environment.SandBankHeight,
+			Environment.SandRoughness,
+			Environment.PerlinOffset,
+			Environment.CliffScale,
+			Environment.CliffIntensity,
+			Environment.CliffRoughness,
+			Environment.CliffRoughnessIntensity,
+			Environment.CliffModifierSeed,
+			Environment.CliffModifierDensity,
+			Environment.CliffModifierIntensity,
+			Environment.CollisionDensity,
+			Environment.MeshTolerance
+		}
+	);
+}
+
+FFixedBeingsParameters FEnvironmentEditorActions::GetFixedBeingsParams(AEnvironment const& Environment)
+{
+	return FFixedBeingsParameters{
+		Environment.FixedBeingPlacingPrecision, Environment.FixedBeingPlacingPasses, Environment.ClusterRange, Environment.bInstanceFixedBeings,
+		Environment.FixedBeingPlacement
+	};
+}
+
+// REGENERATION STUFF
+
+void FEnvironmentEditorActions::RegenerateTerrain(AEnvironment& Environment)
+{
+
+	auto const TerrainManager = GEditor->GetEditorSubsystem<UTerrainManagerEditorSubsystem>();
+	if(!TerrainManager)
+	{
+		UE_LOG(LogTemp, Error, TEXT("TerrainManager is not set"));
+		return;
+	}
+	// the terrain manager works out which stages changed since the last generation
+	TerrainManager->CheckChildren(&Environment);
+	RegenerateEnvironmentInternal(Environment);
+}
+
+
+void FEnvironmentEditorActions::RegenerateEnvironmentInternal(AEnvironment& Environment)
+{
+	// Terrain Generation
+	auto const TerrainManager = GEditor->GetEditorSubsystem<UTerrainManagerEditorSubsystem>();
+	if(!TerrainManager)
+	{
+		UE_LOG(LogTemp, Error, TEXT("TerrainManager is not set"));
+		return;
+	}
+	if(!Environment.TerrainMaterial)
+	{
+		UE_LOG(LogTemp, Error, TEXT("TerrainMaterial is not set"));
+		return;
+	}
+	if(!Environment.CliffCurve)
+	{
+		UE_LOG(LogTemp, Error, TEXT("CliffCurve is not set"));
+		return;
+	}
+
+	// generated in the background, the current terrain stays in place until the new one is ready
+	TerrainManager->RequestTerrain(GetTerrainParams(Environment), Environment.TerrainMaterial, Environment.CliffCurve,
+	                               [this, WeakEnvironment = TWeakObjectPtr<AEnvironment>(&Environment)](ATerrain* NewTerrain)
+	                               {
+		                               if(WeakEnvironment.IsValid())
+		                               {
+			                               OnTerrainGenerated(*WeakEnvironment, NewTerrain);
+		                               }
+	                               });
+}
+
+void FEnvironmentEditorActions::OnTerrainGenerated(AEnvironment& Environment, ATerrain* NewTerrain)
+{
+	auto const TerrainManager = GEditor->GetEditorSubsystem<UTerrainManagerEditorSubsystem>();
+	if(!TerrainManager)
+	{
+		UE_LOG(LogTemp, Error, TEXT("TerrainManager is not set"));
+		return;
+	}
+
+	Environment.TerrainActor = NewTerrain;
+	if(!NewTerrain)
+	{
+		UE_LOG(LogTemp, Error, TEXT("TerrainActor Failed to generate"));
+		return;
+	}
+	NewTerrain->AttachToActor(&Environment, FAttachmentTransformRules::KeepRelativeTransform);
+
+
+	// Log Bounding Box
+	UE_LOG(LogTemp, Warning, TEXT("Terrain Bounding Box: %s"), *TerrainManager->GetBoundingBox2D().ToString());
+
+	RegenerateFixedBeings(Environment);
+}
+
+// FIXED BEINGS STUFF
+
+void FEnvironmentEditorActions::RegenerateFixedBeings(AEnvironment& Environment)
+{
+
+	auto const TerrainManager = GEditor->GetEditorSubsystem<UTerrainManagerEditorSubsystem>();
+	if(!TerrainManager)
+	{
+		UE_LOG(LogTemp, Error, TEXT("TerrainManager is not set"));
+		return;
+	}
+	UE_LOG(LogTemp, Log, TEXT("RegenerateFixedBeings"));
+	if(TerrainManager->IsGenerating())
+	{
+		// the fixed beings are regenerated once the terrain is ready
+		return;
+	}
+	if(!Environment.TerrainActor || !TerrainManager->IsOk())
+	{
+		RegenerateTerrain(Environment);
+		return;
+	}
+
+	AsyncTask(ENamedThreads::GameThread, [this, WeakEnvironment = TWeakObjectPtr<AEnvironment>(&Environment)]()
+	{
+		if(WeakEnvironment.IsValid())
+		{
+			RegenerateFixedBeingsInternal(*WeakEnvironment);
+		}
+	});
+}
+
+void FEnvironmentEditorActions::ClearFixedBeings(AEnvironment& Environment)
+{
+	EditFixedBeings(Environment, NSLOCTEXT("Environment", "ClearFixedBeings", "Clear Fixed Beings"), [&Environment](UFixedBeingsManagerEditorSubsystem& FBManager)
+	{
+		{
+			const FScopedBulkEdit BulkEdit(FBManager.bBulkEdit);
+			FBManager.ClearSpawned();
+		}
+		FBManager.CheckChildren(&Environment);
+	});
+}
+
+/**
+ * Re-place the fixed beings inside FixedBeingsRegion only, the ones outside of it stay where they are.
+ */
+void FEnvironmentEditorActions::RegenerateFixedBeingsInRegion(AEnvironment& Environment)
+{
+	auto const TerrainManager = GEditor->GetEditorSubsystem<UTerrainManagerEditorSubsystem>();
+	if(!TerrainManager || !Environment.TerrainActor || TerrainManager->IsGenerating() || !TerrainManager->IsOk())
+	{
+		UE_LOG(LogTemp, Error, TEXT("Terrain has to be generated before fixed beings can be placed in a region"));
+		return;
+	}
+
+	EditFixedBeings(Environment, NSLOCTEXT("Environment", "RegenerateFixedBeingsInRegion", "Regenerate Fixed Beings in Region"),
+	                [&Environment](UFixedBeingsManagerEditorSubsystem& FBManager)
+	                {
+		                FBManager.CheckChildren(&Environment);
+		                FBManager.RedistributeFixedBeingsInRegion(Environment.FixedBeingsRegion, GetFixedBeingsParams(Environment), &Environment,
+		                                                          Environment.FixedBeingsClasses);
+	                });
+}
+
+/**
+ * Run an edit of the fixed beings as a single undo entry holding the placement before and after it.
+ * The placement before is taken from the beings attached to the environment, the snapshot does not keep its records
+ * across sessions, so regenerating and undoing right after reopening a level puts the saved beings back.
+ * With bulk editing off, the beings themselves are recorded as they are touched instead.
+ *
+ * @param Environment  The environment whose beings are edited.
+ * @param Description  The name of the undo entry.
+ * @param Edit  The edit.
+ */
+void FEnvironmentEditorActions::EditFixedBeings(AEnvironment& Environment, FText const& Description,
+                                                TFunctionRef<void(UFixedBeingsManagerEditorSubsystem&)> Edit)
+{
+	auto const FBManager = GEditor->GetEditorSubsystem<UFixedBeingsManagerEditorSubsystem>();
+	if(!FBManager)
+	{
+		UE_LOG(LogTemp, Error, TEXT("FBManager is not set"));
+		return;
+	}
+
+	UFixedBeingsSnapshot* Snapshot = Environment.FixedBeingsSnapshot;
+	const FScopedTransaction Transaction(Description);
+	const bool               bSnapshot = FBManager->bBulkEdit && Snapshot;
+	if(bSnapshot)
+	{
+		FBManager->CheckChildren(&Environment);
+		FBManager->TakeSnapshot(*Snapshot);
+		Snapshot->Modify();
+	}
+
+	Edit(*FBManager);
+
+	if(bSnapshot)
+	{
+		FBManager->TakeSnapshot(*Snapshot);
+	}
+}
+
+
+/**
+ * Bake the current terrain into BakedHeightfield, creating the asset next to the level if there is none.
+ * The asset still has to be saved.
+ */
+void FEnvironmentEditorActions::BakeTerrain(AEnvironment& Environment)
+{
+	auto const TerrainManager = GEditor->GetEditorSubsystem<UTerrainManagerEditorSubsystem>();
+	if(!TerrainManager || !TerrainManager->IsOk())
+	{
+		UE_LOG(LogTemp, Error, TEXT("Terrain has to be generated before it can be baked"));
+		return;
+	}
+
+	if(!Environment.BakedHeightfield)
+	{
+		const FString PackagePath = FPackageName::GetLongPackagePath(Environment.GetWorld()->GetPackage()->GetName());
+		const FString AssetName = Environment.GetName() + TEXT("_Heightfield");
+		UPackage* Package = CreatePackage(*FPaths::Combine(PackagePath, AssetName));
+		Environment.BakedHeightfield = NewObject<UTerrainHeightfield>(Package, *AssetName, RF_Public | RF_Standalone | RF_Transactional);
+		FAssetRegistryModule::AssetCreated(Environment.BakedHeightfield);
+		Environment.Modify();
+	}
+
+	if(TerrainManager->BakeHeightfield(Environment.BakedHeightfield))
+	{
+		UE_LOG(LogTemp, Log, TEXT("Baked terrain into %s"), *Environment.BakedHeightfield->GetPathName());
+	}
+}
+
+
+/**
+ * Write the depth, slope and curvature rasters the fixed beings are placed with to Saved/PlacementRasters.
+ */
+void FEnvironmentEditorActions::ExportPlacementRasters(AEnvironment& Environment)
+{
+	auto const FBManager = GEditor->GetEditorSubsystem<UFixedBeingsManagerEditorSubsystem>();
+	if(!FBManager)
+	{
+		UE_LOG(LogTemp, Error, TEXT("FBManager is not set"));
+		return;
+	}
+	if(!FBManager->ExportPlacementRasters())
+	{
+		UE_LOG(LogTemp, Error, TEXT("Terrain has to be generated before its placement rasters can be exported"));
+	}
+}
+
+
+void FEnvironmentEditorActions::RegenerateFixedBeingsInternal(AEnvironment& Environment)
+{
+
+	if(!Environment.TerrainActor)
+	{
+		UE_LOG(LogTemp, Error, TEXT("TerrainActor is not set"));
+		return;
+	}
+
+	EditFixedBeings(Environment, NSLOCTEXT("Environment", "RegenerateFixedBeings", "Regenerate Fixed Beings"),
+	                [&Environment](UFixedBeingsManagerEditorSubsystem& FBManager)
+	                {
+		                FBManager.CheckChildren(&Environment);
+		                FBManager.RedistributeFixedBeings(GetFixedBeingsParams(Environment), &Environment, Environment.FixedBeingsClasses);
+	                });
+}
+
+void FEnvironmentEditorActions::RestorePlacement(UFixedBeingsSnapshot const& Snapshot, AActor* Parent)
+{
+	if(auto const FBManager = GEditor ? GEditor->GetEditorSubsystem<UFixedBeingsManagerEditorSubsystem>() : nullptr)
+	{
+		FBManager->RestorePlacement(Snapshot, Parent);
+	}
+}
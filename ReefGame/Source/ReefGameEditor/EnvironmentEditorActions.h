@@ -0,0 +1,34 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ReefGame/EnvironmentEditor.h"
+
+struct FTerrainParameters;
+struct FFixedBeingsParameters;
+class ATerrain;
+class UFixedBeingsManagerEditorSubsystem;
+
+/**
+ * Generates, edits and bakes the environments through the terrain and fixed beings managers.
+ * Registered with the runtime module by ReefGameEditor, the buttons and the undo of an environment end up here.
+ */
+class REEFGAMEEDITOR_API FEnvironmentEditorActions : public IEnvironmentEditor {
+	void RegenerateEnvironmentInternal(AEnvironment& Environment);
+	void OnTerrainGenerated(AEnvironment& Environment, ATerrain* NewTerrain);
+	void RegenerateFixedBeingsInternal(AEnvironment& Environment);
+	void EditFixedBeings(AEnvironment& Environment, FText const& Description, TFunctionRef<void(UFixedBeingsManagerEditorSubsystem&)> Edit);
+
+public:
+	// What the terrain and the fixed beings of an environment are generated with, taken from its properties
+	static FTerrainParameters     GetTerrainParams(AEnvironment const& Environment);
+	static FFixedBeingsParameters GetFixedBeingsParams(AEnvironment const& Environment);
+
+	virtual void OnConstruction(AEnvironment& Environment) override;
+	virtual void RegenerateTerrain(AEnvironment& Environment) override;
+	virtual void RegenerateFixedBeings(AEnvironment& Environment) override;
+	virtual void RegenerateFixedBeingsInRegion(AEnvironment& Environment) override;
+	virtual void ClearFixedBeings(AEnvironment& Environment) override;
+	virtual void BakeTerrain(AEnvironment& Environment) override;
+	virtual void ExportPlacementRasters(AEnvironment& Environment) override;
+	virtual void RestorePlacement(UFixedBeingsSnapshot const& Snapshot, AActor* Parent) override;
+};
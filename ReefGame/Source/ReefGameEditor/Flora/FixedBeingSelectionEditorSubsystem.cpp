@@ -0,0 +1,64 @@
+#include "FixedBeingSelectionEditorSubsystem.h"
+#include "ReefGame/Flora/FixedBeing.h"
+#include "DrawDebugHelpers.h"
+#include "Editor.h"
+#include "Selection.h"
+
+void UFixedBeingSelectionEditorSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	SelectionChangedHandle = USelection::SelectionChangedEvent.AddUObject(this, &UFixedBeingSelectionEditorSubsystem::OnSelectionChanged);
+	if(GEditor)
+	{
+		OnSelectionChanged(GEditor->GetSelectedActors());
+	}
+}
+
+void UFixedBeingSelectionEditorSubsystem::Deinitialize()
+{
+	USelection::SelectionChangedEvent.Remove(SelectionChangedHandle);
+	SelectedBeings.Empty();
+
+	Super::Deinitialize();
+}
+
+void UFixedBeingSelectionEditorSubsystem::OnSelectionChanged(UObject* Selection)
+{
+	// the component and object selections broadcast the same event
+	if(!GEditor || Selection != GEditor->GetSelectedActors())
+	{
+		return;
+	}
+
+	TArray<AFixedBeing*> Beings;
+	GEditor->GetSelectedActors()->GetSelectedObjects<AFixedBeing>(Beings);
+
+	SelectedBeings.Reset(Beings.Num());
+	for(AFixedBeing* Being : Beings)
+	{
+		SelectedBeings.Add(Being);
+	}
+}
+
+void UFixedBeingSelectionEditorSubsystem::Tick(float DeltaTime)
+{
+	for(int32 i = SelectedBeings.Num() - 1; i >= 0; i--)
+	{
+		const AFixedBeing* Being = SelectedBeings[i].Get();
+		if(!Being)
+		{
+			SelectedBeings.RemoveAtSwap(i, 1, false);
+			continue;
+		}
+		if(Being->Placement.ClusterRadius > 0)
+		{
+			DrawDebugSphere(Being->GetWorld(), Being->GetActorLocation(), Being->Placement.ClusterRadius, SphereSegments, FColor::FromHex("AAAAAAAA"), false, -1, 0, 1);
+		}
+	}
+}
+
+TStatId UFixedBeingSelectionEditorSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFixedBeingSelectionEditorSubsystem, STATGROUP_Tickables);
+}
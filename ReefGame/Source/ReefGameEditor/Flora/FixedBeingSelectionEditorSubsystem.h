@@ -0,0 +1,35 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorSubsystem.h"
+#include "TickableEditorObject.h"
+#include "FixedBeingSelectionEditorSubsystem.generated.h"
+
+class AFixedBeing;
+
+/**
+ * Draws the cluster radius of the selected fixed beings in the editor viewports.
+ * It listens to the editor selection once for all beings and only ticks while a fixed being is selected,
+ * so the beings themselves never tick in the editor.
+ */
+UCLASS()
+class REEFGAMEEDITOR_API UFixedBeingSelectionEditorSubsystem : public UEditorSubsystem, public FTickableEditorObject {
+	GENERATED_BODY()
+
+	TArray<TWeakObjectPtr<AFixedBeing>> SelectedBeings;
+	FDelegateHandle                     SelectionChangedHandle;
+
+	void OnSelectionChanged(UObject* Selection);
+
+public:
+	// Segments of the drawn spheres, enough to read the radius without drawing thousands of lines per being
+	int32 SphereSegments = 24;
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	virtual void              Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override { return ETickableTickType::Conditional; }
+	virtual bool              IsTickable() const override { return SelectedBeings.Num() > 0; }
+	virtual TStatId           GetStatId() const override;
+};
@@ -0,0 +1,2002 @@
+#include "FixedBeingsManagerEditorSubsystem.h"
+#include "ReefGameEditor/DiskCache.h"
+#include "ReefGame/Flora/FixedBeing.h"
+#include "ReefGame/Flora/FixedBeingInstancesComponent.h"
+#include "ReefGame/Flora/FixedBeingsSnapshot.h"
+#include "ReefGame/ScopedBulkEdit.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Misc/ScopedSlowTask.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Rotate.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "ProfilingDebugging/ScopedTimers.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "TimerManager.h"
+
+namespace
+{
+	// Construction scripts closer together than this are coalesced into one CheckChildren, a drag in the viewport runs one every frame
+	constexpr float CheckChildrenDelay = 0.25f;
+}
+
+namespace PlacementCache
+{
+	// Bump whenever the placement or the file layout changes so old entries are never reused
+	constexpr uint32 Version = 2;
+	constexpr uint32 Magic = 0x50424652; // "RFBP"
+	// A placement of a hundred thousand beings takes up about 10MB
+	constexpr int64 MaxBytes = 256ll * 1024 * 1024;
+}
+
+namespace
+{
+	FSpawnedBeing MakeSpawnedBeing(AFixedBeing* Being, FVector const& Location)
+	{
+		FSpawnedBeing Spawned;
+		Spawned.Location = Location;
+		Spawned.Being = Being;
+		Spawned.Class = Being->GetClass();
+		Spawned.MinimumSpacing = Being->MinimumSpacing;
+		return Spawned;
+	}
+}
+
+// Unreal Overrides
+
+void UFixedBeingsManagerEditorSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+}
+
+void UFixedBeingsManagerEditorSubsystem::Deinitialize()
+{
+	Super::Deinitialize();
+
+	if(GEditor)
+	{
+		GEditor->GetTimerManager()->ClearTimer(CheckChildrenTimer);
+	}
+
+	ClearAll();
+}
+
+void UFixedBeingsManagerEditorSubsystem::ReleaseAll()
+{
+    SpawnedBeings.Empty();
+    SpawnedActors.Empty();
+    ClearPicker();
+}
+
+// Setters
+
+/**
+ * @brief Sets the seed value for the subsystem and updates related properties.
+ *
+ * This function sets the Seed every placement draw is hashed with
+ * and marks the subsystem as dirty, indicating that there are unsaved changes.
+ *
+ * @param NewSeed The new seed value to be used for the subsystem.
+ */
+void UFixedBeingsManagerEditorSubsystem::SetSeed(int32 NewSeed)
+{
+	Seed = NewSeed;
+	bDirty = true;
+}
+
+/**
+ * @brief Updates the list of classes that represent fixed beings.
+ *
+ * This function sets the FixedBeingsClasses property to the provided list of classes
+ * and marks the subsystem as dirty, indicating that there are unsaved changes.
+ *
+ * @param NewClasses A constant reference to an array of TSubclassOf<AFixedBeing> representing the new classes
+ *                   for fixed beings.
+ */
+void UFixedBeingsManagerEditorSubsystem::SetFixedBeingsClasses(TArray<TSubclassOf<AFixedBeing>> const& NewClasses)
+{
+	FixedBeingsClasses = NewClasses;
+	PickerBuckets.Reset();
+	bDirty = true;
+}
+
+// Cleaners
+
+/**
+ * @brief Clears all the data managed by the Fixed Beings Manager Editor Subsystem.
+ *
+ * This function invokes ClearPicker() to clear any selections in the picker tool,
+ * and ClearSpawned() to remove all spawned actors from the subsystem.
+ */
+void UFixedBeingsManagerEditorSubsystem::ClearAll()
+{
+	ClearPicker();
+	ClearSpawned();
+}
+
+/**
+ * @brief Destroys all spawned beings managed by the subsystem.
+ *
+ * This function iterates over all actors in the SpawnedBeings array and
+ * destroys them if they are valid, and empties every instance component. After that the
+ * SpawnedBeings array is cleared to remove all references to these beings.
+ */
+void UFixedBeingsManagerEditorSubsystem::ClearSpawned()
+{
+	for(auto& SpawnedBeing : SpawnedBeings)
+	{
+		if(auto Being = SpawnedBeing.Being.Get())
+		{
+			if(IsValid(Being))
+			{
+				Being->Destroy();
+			}
+		}
+	}
+	for(auto& WComponent : InstanceComponents)
+	{
+		if(auto Component = WComponent.Get())
+		{
+			Component->ClearBeings();
+		}
+	}
+	SpawnedBeings.Empty();
+	SpawnedActors.Empty();
+	PlacementRecords.Reset();
+	SpatialIndex.Reset(Parameters.ClusterRange);
+	PassIndex.Reset(Parameters.ClusterRange);
+}
+
+/**
+ * @brief Indexes every spawned being by location for the spacing and clustering checks.
+ *
+ * The cells are as large as the cluster range, or the largest minimum spacing of the classes being placed if that is larger,
+ * so a candidate never has to look further than the cells next to its own.
+ */
+void UFixedBeingsManagerEditorSubsystem::RebuildSpatialIndex()
+{
+	float CellSize = Parameters.ClusterRange;
+	for(auto& Class : FixedBeingsClasses)
+	{
+		if(const AFixedBeing* Default = Class ? Class->GetDefaultObject<AFixedBeing>() : nullptr)
+		{
+			CellSize = FMath::Max(CellSize, Default->MinimumSpacing);
+		}
+	}
+
+	SpatialIndex.Reset(CellSize);
+	MergePassIndex(0);
+}
+
+/**
+ * @brief Moves the beings placed since PassBegin into the spatial index the next pass is evaluated against.
+ *
+ * @param PassBegin  The number of spawned beings when the pass started.
+ */
+void UFixedBeingsManagerEditorSubsystem::MergePassIndex(const int32 PassBegin)
+{
+	for(int32 i = PassBegin; i < SpawnedBeings.Num(); i++)
+	{
+		if(SpawnedBeings[i].IsValid())
+		{
+			SpatialIndex.Add(i, SpawnedBeings[i].Location, SpawnedBeings[i].MinimumSpacing);
+		}
+	}
+	PassIndex.Reset(SpatialIndex.GetCellSize());
+}
+
+/**
+ * @brief Adds a being to SpawnedBeings, keeping SpawnedActors in step.
+ *
+ * @param Spawned  The being, either an actor or an instance.
+ * @return The index of the being in SpawnedBeings.
+ */
+int32 UFixedBeingsManagerEditorSubsystem::AddSpawnedBeing(FSpawnedBeing const& Spawned)
+{
+	if(const AFixedBeing* Being = Spawned.Being.Get())
+	{
+		SpawnedActors.Add(Being);
+	}
+	return SpawnedBeings.Add(Spawned);
+}
+
+/**
+ * @brief Reconciles the fixed beings attached to the environment with the spawned beings and the picker.
+ *
+ * Known children are found in SpawnedActors, so this is a set lookup per child. The picker is only searched,
+ * once, if a child turns up that was not spawned, which only happens when an undo brings back a being that had gone to the picker.
+ * The instances of a component that do not match the spawned beings, those of a reopened level, are registered again,
+ * and the placement records are rebuilt whenever they no longer cover the spawned beings.
+ *
+ * @param Parent  The environment.
+ */
+void UFixedBeingsManagerEditorSubsystem::CheckChildren(const AActor* Parent)
+{
+	// Anything pending for this parent is covered now
+	if(PendingCheckParent.Get() == Parent)
+	{
+		PendingCheckParent.Reset();
+		if(GEditor)
+		{
+			GEditor->GetTimerManager()->ClearTimer(CheckChildrenTimer);
+		}
+	}
+
+	TArray<AActor*> Children;
+	Parent->GetAttachedActors(Children);
+
+	// First, clean up invalid references in SpawnedBeings, a deleted being that an undo brings back has to be registered again
+	const int32 NumOfPruned = SpawnedBeings.RemoveAll([](const FSpawnedBeing& SpawnedBeing) {
+		return !SpawnedBeing.IsValid();
+	});
+	if(NumOfPruned > 0)
+	{
+		SpawnedActors.Reset();
+		for(const FSpawnedBeing& SpawnedBeing : SpawnedBeings)
+		{
+			if(const AFixedBeing* Being = SpawnedBeing.Being.Get())
+			{
+				SpawnedActors.Add(Being);
+			}
+		}
+	}
+
+	// Instance components saved with the environment are cleared along with the actors, and their instances are spawned beings like any other
+	TArray<UFixedBeingInstancesComponent*> Components;
+	Parent->GetComponents(Components);
+	bool bRegistered = false;
+	if(Components.Num() > 0)
+	{
+		TMap<const UFixedBeingInstancesComponent*, int32> NumOfRegistered;
+		for(const FSpawnedBeing& SpawnedBeing : SpawnedBeings)
+		{
+			if(const UFixedBeingInstancesComponent* Instances = SpawnedBeing.Instances.Get())
+			{
+				NumOfRegistered.FindOrAdd(Instances)++;
+			}
+		}
+		for(auto Component : Components)
+		{
+			InstanceComponents.AddUnique(Component);
+			if(NumOfRegistered.FindRef(Component) != Component->GetInstanceCount())
+			{
+				RegisterInstances(Component);
+				bRegistered = true;
+			}
+		}
+	}
+
+	// Beings in the picker by bucket and position, built the first time a child is not among the spawned beings
+	TMap<TObjectKey<AFixedBeing>, int32> PooledBuckets;
+	bool                                 bPooledBucketsBuilt = false;
+
+	// iterate through the actors, if they are fixed beings check if they are in the SpawnedBeings or Picker_Internal, if not, register them
+	for(const auto& Child : Children)
+	{
+		AFixedBeing* FixedBeing = Cast<AFixedBeing>(Child);
+		if(!FixedBeing || SpawnedActors.Contains(FixedBeing))
+		{
+			continue;
+		}
+
+		if(!bPooledBucketsBuilt)
+		{
+			for(int32 Bucket = 0; Bucket < Picker_Internal.Num(); Bucket++)
+			{
+				for(const AFixedBeing* Pooled : Picker_Internal[Bucket].Beings)
+				{
+					PooledBuckets.Add(Pooled, Bucket);
+				}
+			}
+			bPooledBucketsBuilt = true;
+		}
+
+		// Move from picker to spawned
+		if(const int32* Bucket = PooledBuckets.Find(FixedBeing))
+		{
+			Picker_Internal[*Bucket].Beings.RemoveSingle(FixedBeing);
+
+			// unHide the actor
+			FixedBeing->SetActorHiddenInGame(false);
+
+			// Enable collision
+			FixedBeing->SetActorEnableCollision(true);
+
+			FixedBeing->SetActorTickEnabled(true);
+		}
+
+		// Either way it is a spawned being from now on, placed beings are indexed relative to the environment
+		const FVector Location = FixedBeing->GetRootComponent() ? FixedBeing->GetRootComponent()->GetRelativeLocation() : FixedBeing->GetActorLocation();
+		AddSpawnedBeing(MakeSpawnedBeing(FixedBeing, Location));
+		bRegistered = true;
+	}
+
+	// a region redistribution and the placement cache work from the records, they have to cover what is placed
+	if(FixedBeingsClasses.Num() > 0 && (bRegistered || PlacementRecords.Num() != SpawnedBeings.Num()))
+	{
+		RebuildPlacementRecords();
+	}
+}
+
+/**
+ * @brief Registers every instance of a component as a spawned being, in place of whatever was registered for it.
+ *
+ * @param Component  The instances of one class, saved with the environment or changed by an undo.
+ */
+void UFixedBeingsManagerEditorSubsystem::RegisterInstances(UFixedBeingInstancesComponent* Component)
+{
+	SpawnedBeings.RemoveAll([Component](const FSpawnedBeing& SpawnedBeing) {
+		return SpawnedBeing.Instances.Get() == Component;
+	});
+
+	const AFixedBeing* Default = Component->BeingClass ? Component->BeingClass->GetDefaultObject<AFixedBeing>() : nullptr;
+	const FTransform   InverseMeshTransform = Component->MeshTransform.Inverse();
+	for(int32 i = 0; i < Component->GetInstanceCount(); i++)
+	{
+		FTransform InstanceTransform;
+		Component->GetInstanceTransform(i, InstanceTransform, false);
+
+		FSpawnedBeing Spawned;
+		Spawned.Location = (InverseMeshTransform * InstanceTransform).GetLocation();
+		Spawned.Instances = Component;
+		Spawned.InstanceIndex = i;
+		Spawned.Class = Component->BeingClass;
+		Spawned.MinimumSpacing = Default ? Default->MinimumSpacing : 0.f;
+		AddSpawnedBeing(Spawned);
+	}
+
+	// the environment was placed as instances
+	if(Component->GetInstanceCount() > 0)
+	{
+		Parameters.bInstanced = true;
+	}
+}
+
+/**
+ * @brief Rebuilds the placement records from the spawned beings, for the beings placed before this session or brought back by an undo.
+ *
+ * Beings whose class is not among the fixed beings classes have no record.
+ */
+void UFixedBeingsManagerEditorSubsystem::RebuildPlacementRecords()
+{
+	PlacementRecords.Reset(SpawnedBeings.Num());
+	for(const FSpawnedBeing& SpawnedBeing : SpawnedBeings)
+	{
+		FPlacementRecord Record;
+		const int32      ClassIndex = SpawnedBeing.Class ? GetPickerBucket(SpawnedBeing.Class) : INDEX_NONE;
+		if(ClassIndex != INDEX_NONE && MakePlacementRecord(SpawnedBeing, ClassIndex, Record))
+		{
+			PlacementRecords.Add(Record);
+		}
+	}
+}
+
+/**
+ * @brief Describes a spawned being as a placement record, the way SpawnFixedBeing would have recorded it.
+ *
+ * @param Spawned  The being, either an actor or an instance.
+ * @param ClassIndex  The class the record puts back.
+ * @param OutRecord  The record.
+ * @return false if the being is gone.
+ */
+bool UFixedBeingsManagerEditorSubsystem::MakePlacementRecord(FSpawnedBeing const& Spawned, const int32 ClassIndex, FPlacementRecord& OutRecord)
+{
+	OutRecord.ClassIndex = ClassIndex;
+	if(const AFixedBeing* Being = Spawned.Being.Get())
+	{
+		// placed beings are attached with their location relative to the environment
+		const FTransform Transform = Being->GetRootComponent() ? Being->GetRootComponent()->GetRelativeTransform() : Being->GetActorTransform();
+		OutRecord.Location = FVector3f(Transform.GetLocation());
+		OutRecord.Rotation = FQuat4f(Transform.GetRotation());
+		OutRecord.Placement = Being->Placement;
+		return true;
+	}
+	if(const UFixedBeingInstancesComponent* Instances = Spawned.Instances.Get())
+	{
+		FTransform InstanceTransform;
+		if(!Instances->GetInstanceTransform(Spawned.InstanceIndex, InstanceTransform, false))
+		{
+			return false;
+		}
+		const FTransform Transform = Instances->MeshTransform.Inverse() * InstanceTransform;
+		OutRecord.Location = FVector3f(Transform.GetLocation());
+		OutRecord.Rotation = FQuat4f(Transform.GetRotation());
+		OutRecord.Placement = Instances->Placements.IsValidIndex(Spawned.InstanceIndex) ? Instances->Placements[Spawned.InstanceIndex] : FFixedBeingPlacement();
+		return true;
+	}
+	return false;
+}
+
+/**
+ * @brief Runs CheckChildren once the construction scripts of a parent stop coming.
+ *
+ * Every call pushes the check back, so dragging the environment or scrubbing one of its properties
+ * reconciles the children once at the end rather than on every construction script.
+ *
+ * @param Parent  The environment.
+ */
+void UFixedBeingsManagerEditorSubsystem::RequestCheckChildren(const AActor* Parent)
+{
+	if(!GEditor)
+	{
+		CheckChildren(Parent);
+		return;
+	}
+
+	// A different environment cannot wait for this one
+	if(PendingCheckParent.IsValid() && PendingCheckParent.Get() != Parent)
+	{
+		FlushCheckChildren();
+	}
+
+	PendingCheckParent = Parent;
+	GEditor->GetTimerManager()->SetTimer(CheckChildrenTimer, FTimerDelegate::CreateUObject(this, &UFixedBeingsManagerEditorSubsystem::FlushCheckChildren),
+	                                     CheckChildrenDelay, false);
+}
+
+void UFixedBeingsManagerEditorSubsystem::FlushCheckChildren()
+{
+	if(const AActor* Parent = PendingCheckParent.Get())
+	{
+		CheckChildren(Parent);
+	}
+	PendingCheckParent.Reset();
+}
+
+/**
+ * @brief Clears all the entries in the Picker_Internal array.
+ *
+ * This function iterates over each sub-array within the Picker_Internal array.
+ * For each sub-array, it destroys all valid AFixedBeing objects and then empties the sub-array.
+ */
+void UFixedBeingsManagerEditorSubsystem::ClearPicker()
+{
+	for(auto& Array : Picker_Internal)
+	{
+		for(int32 i = Array.Num() - 1; i >= 0; --i)
+		{
+			if(Array[i] && IsValid(Array[i]))
+			{
+				Array[i]->Destroy();
+			}
+		}
+		Array.Empty();
+	}
+	RuleTable.Reset();
+	FrontRules.Empty();
+	FrontMatchesTable.Empty();
+}
+
+// Picker
+
+/**
+ * @brief Despawns all currently spawned beings and organizes them into the picker array.
+ *
+ * This function iterates over all the spawned beings. For each valid actor, detaches the actor from its parent,
+ * hides it, disables its collision and tick updates, and then adds it to the appropriate category in the picker.
+ * Finally, it clears the list of remaining spawned beings.
+ */
+void UFixedBeingsManagerEditorSubsystem::DespawnToPicker()
+{
+	auto& Picker = GetPicker();
+	// remove all from the spawned array and organise them in the picker. anything that is not in the picker is destroyed
+	// put all in picker
+	for(auto& SpawnedBeing : SpawnedBeings)
+	{
+		if(SpawnedBeing.Being.IsValid() && IsValid(SpawnedBeing.Being.Get()))
+		{
+			auto        Actor = SpawnedBeing.Being.Get();
+			const int32 Bucket = GetPickerBucket(Actor->GetClass());
+			if(Bucket != INDEX_NONE)
+			{
+				Picker[Bucket].Add(Actor);
+			}
+		}
+	}
+	// remove from spawned
+	ClearSpawned();
+}
+
+void FIndividualPicker::Add(AFixedBeing* const Being)
+{
+
+	// Detach from parent
+	Being->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+
+	// Hide the actor
+	Being->SetActorHiddenInGame(true);
+
+	// Disable collision to make sure it does not interfere with other objects
+	Being->SetActorEnableCollision(false);
+
+	Being->SetActorTickEnabled(false);
+	Beings.Add(Being);
+}
+
+void FIndividualPicker::RemoveAt(int32 const Index)
+{ Beings.RemoveAt(Index); }
+
+/**
+ * @brief Retrieves and initializes the picker array for fixed beings.
+ *
+ * This function returns a reference to the Picker_Internal array. If the Picker_Internal array's size does not match
+ * the FixedBeingsClasses array size, or if the bDirty flag is set, it reinitialises the Picker_Internal array with one empty bucket per class.
+ * Nothing is spawned here, ReservePicker fills the buckets before a placement takes from them.
+ *
+ * @return A reference to the Picker array.
+ */
+TArray<FIndividualPicker>& UFixedBeingsManagerEditorSubsystem::GetPicker()
+{
+	if(Picker_Internal.Num() != FixedBeingsClasses.Num() || bDirty)
+	{
+		ClearPicker();
+		Picker_Internal.Init(FIndividualPicker(), FixedBeingsClasses.Num());
+		PickerBuckets.Reset();
+		for(int32 i = 0; i < FixedBeingsClasses.Num(); i++)
+		{
+			PickerBuckets.FindOrAdd(FixedBeingsClasses[i].Get(), i);
+		}
+	}
+	bDirty = false;
+	return Picker_Internal;
+}
+
+/**
+ * @brief Makes sure every bucket of the picker holds enough beings, spawning the missing ones in one go.
+ *
+ * Called before a placement so the placement itself only takes from the picker and never spawns.
+ * Every bucket keeps at least one being, its rules are what a candidate of the class is evaluated with.
+ * The beings spawned here are put under the ones already pooled, so topping a bucket up never changes its front.
+ *
+ * @param NumOfBeings  How many beings each bucket should hold, by class index.
+ */
+void UFixedBeingsManagerEditorSubsystem::ReservePicker(TArrayView<const int32> NumOfBeings)
+{
+	auto& Picker = GetPicker();
+
+	UWorld* World = GEditor->GetEditorWorldContext().World();
+	if(!World)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to get World context"));
+		return;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	SpawnParams.ObjectFlags = RF_Transactional;
+
+	for(int32 i = 0; i < Picker.Num(); i++)
+	{
+		const int32 Wanted = FMath::Max(NumOfBeings.IsValidIndex(i) ? NumOfBeings[i] : 0, 1);
+		const int32 NumOfPooled = Picker[i].Num();
+		Picker[i].Beings.Reserve(Wanted);
+		while(Picker[i].Num() < Wanted)
+		{
+			AFixedBeing* Actor = World->SpawnActor<AFixedBeing>(FixedBeingsClasses[i], FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
+			if(!Actor)
+			{
+				UE_LOG(LogTemp, Error, TEXT("FBManager: Failed to spawn %s"), *GetNameSafe(FixedBeingsClasses[i]));
+				break;
+			}
+			Picker[i].Add(Actor);
+		}
+		// the new beings go under the pooled ones, the front of the bucket is what the rule table was built from
+		Algo::Rotate(Picker[i].Beings, NumOfPooled);
+	}
+}
+
+/**
+ * @brief Finds the picker bucket a class of being goes to.
+ *
+ * @param Class  The class of a being.
+ * @return The index of the first listed class it is a child of, or INDEX_NONE.
+ */
+int32 UFixedBeingsManagerEditorSubsystem::GetPickerBucket(UClass* Class)
+{
+	if(const int32* Bucket = PickerBuckets.Find(Class))
+	{
+		return *Bucket;
+	}
+
+	// Subclasses of the listed classes are looked up once and remembered
+	int32 Bucket = INDEX_NONE;
+	for(int32 i = 0; i < FixedBeingsClasses.Num(); i++)
+	{
+		if(Class && Class->IsChildOf(FixedBeingsClasses[i]))
+		{
+			Bucket = i;
+			break;
+		}
+	}
+	PickerBuckets.Add(Class, Bucket);
+	return Bucket;
+}
+
+/**
+ * @brief Whether a being of this class is placed as an instance rather than as an actor taken from the picker.
+ *
+ * @param Being  A being of the class.
+ * @return true if the placement is instanced, the being can do without its actor and has a single static mesh to instance.
+ */
+bool UFixedBeingsManagerEditorSubsystem::CanBeInstanced(AFixedBeing const* Being) const
+{
+	if(!Parameters.bInstanced || !Being || Being->bNeedsActor)
+	{
+		return false;
+	}
+	// the instances only draw a single mesh, a being made of several keeps its actor
+	TInlineComponentArray<UStaticMeshComponent*> Meshes(Being);
+	return Meshes.Num() == 1 && Meshes[0]->GetStaticMesh();
+}
+
+// Regions
+
+/**
+ * @brief Redistributes the fixed beings inside a region only, the beings outside of it stay as they are.
+ *
+ * The candidates are walked exactly as for the whole reef and the ones outside the region are dropped, the beings around
+ * the region stay in the spatial index so the spacing and clusters across its border are kept. Nothing is read from
+ * or written to the placement cache, the placement no longer is what the whole reef would get.
+ *
+ * @param Region  The region, in the space of the parent like the being locations.
+ * @param NewParameters  The parameters to place with.
+ * @param Parent  The actor the beings are placed under.
+ * @param NewClasses  The classes to place, the beings outside the region keep their class even if it is no longer listed.
+ */
+void UFixedBeingsManagerEditorSubsystem::RedistributeFixedBeingsInRegion(FBox2D const& Region, FFixedBeingsParameters NewParameters, AActor* Parent,
+                                                                         TArray<TSubclassOf<AFixedBeing>> const& NewClasses)
+{
+	const FScopedBulkEdit BulkEdit(bBulkEdit);
+
+	if(!Region.bIsValid)
+	{
+		UE_LOG(LogTemp, Error, TEXT("FBManager: The region to redistribute is not valid"));
+		return;
+	}
+
+	if(!TerrainManager)
+	{
+		TerrainManager = GEditor->GetEditorSubsystem<UTerrainManagerEditorSubsystem>();
+	}
+	if(!TerrainManager || !TerrainManager->IsOk())
+	{
+		UE_LOG(LogTemp, Error, TEXT("FBManager: Terrain Manager is not set or not properly initialized"));
+		return;
+	}
+	if(NewClasses.Num() == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("FBManager: No Fixed Beings Classes to be placed"));
+		return;
+	}
+
+	// the records of the beings that stay are rebuilt against the new list, the beings of a class it does not have get none
+	if(NewClasses != FixedBeingsClasses)
+	{
+		SetFixedBeingsClasses(NewClasses);
+		RebuildPlacementRecords();
+	}
+	Parameters = NewParameters;
+
+	const int32 NumberOfPasses = Parameters.Placement == EFixedBeingPlacement::PoissonDisk ? 1 : Parameters.FixedBeingPlacingPasses;
+	const float NumberOfTasks =
+	+1 // Fixed Beings Preparation
+	+ NumberOfPasses // Fixed Beings Placement Begin
+	+ NumberOfPasses * TerrainManager->NumOfXVertices * TerrainManager->NumOfYVertices // Fixed Beings Placement
+	;
+	FScopedSlowTask Progress(NumberOfTasks, FText::FromString("Redistributing Fixed Beings in Region"));
+	// commandlets run headless, the progress only goes to the log there
+	if(!IsRunningCommandlet())
+	{
+		Progress.MakeDialog(true, true);
+	}
+
+	Progress.EnterProgressFrame(1.f, FText::FromString(TEXT("Preparing Fixed Beings...")));
+
+	if(Progress.ShouldCancel() || !UpdateRasters())
+	{
+		return;
+	}
+
+	DespawnRegionToPicker(Region);
+	RebuildSpatialIndex();
+
+	PlacementRegion = Region;
+	bool bCompleted = true;
+	if(Parameters.Placement == EFixedBeingPlacement::PoissonDisk)
+	{
+		bCompleted = PlacePoissonDisk(Progress, Parent);
+	}
+	else
+	{
+		for(int32 i = 1; i <= Parameters.FixedBeingPlacingPasses && bCompleted; i++)
+		{
+			bCompleted = PlaceFixedBeingsPass(i, Progress, Parent);
+		}
+	}
+	PlacementRegion.Reset();
+
+	ClearPicker();
+}
+
+/**
+ * @brief Takes the spawned beings inside a region out of the environment, the actors go back to the picker and the instances are removed.
+ *
+ * @param Region  The region, in the space of the being locations.
+ */
+void UFixedBeingsManagerEditorSubsystem::DespawnRegionToPicker(FBox2D const& Region)
+{
+	auto& Picker = GetPicker();
+
+	TMap<UFixedBeingInstancesComponent*, TArray<int32>> RemovedInstances;
+	for(FSpawnedBeing& SpawnedBeing : SpawnedBeings)
+	{
+		if(!SpawnedBeing.IsValid() || !Region.IsInside(FVector2D(SpawnedBeing.Location)))
+		{
+			continue;
+		}
+
+		if(AFixedBeing* Being = SpawnedBeing.Being.Get())
+		{
+			SpawnedActors.Remove(Being);
+			const int32 Bucket = GetPickerBucket(Being->GetClass());
+			if(Bucket != INDEX_NONE)
+			{
+				Picker[Bucket].Add(Being);
+			}
+			else
+			{
+				Being->Destroy();
+			}
+		}
+		else if(UFixedBeingInstancesComponent* Instances = SpawnedBeing.Instances.Get())
+		{
+			RemovedInstances.FindOrAdd(Instances).Add(SpawnedBeing.InstanceIndex);
+		}
+
+		// dropped below
+		SpawnedBeing = FSpawnedBeing();
+	}
+
+	// the instances after a removed one move down
+	for(auto& Pair : RemovedInstances)
+	{
+		Pair.Value.Sort();
+		Pair.Key->RemoveBeings(Pair.Value);
+	}
+	if(RemovedInstances.Num() > 0)
+	{
+		for(FSpawnedBeing& SpawnedBeing : SpawnedBeings)
+		{
+			if(const TArray<int32>* Removed = RemovedInstances.Find(SpawnedBeing.Instances.Get()))
+			{
+				SpawnedBeing.InstanceIndex -= Algo::LowerBound(*Removed, SpawnedBeing.InstanceIndex);
+			}
+		}
+	}
+
+	SpawnedBeings.RemoveAll([](const FSpawnedBeing& SpawnedBeing) {
+		return !SpawnedBeing.IsValid();
+	});
+	PlacementRecords.RemoveAll([&Region](const FPlacementRecord& Record) {
+		return Region.IsInside(FVector2D(FVector(Record.Location)));
+	});
+}
+
+/**
+ * @brief Drops the candidates of a pass that cannot land in PlacementRegion, keeping the rows and the keys of the others.
+ *
+ * The candidates are in grid vertices while the region is in the space of the beings, which the cliffs displace,
+ * so the region is grown by the largest displacement here and the exact test is made on the sampled position.
+ *
+ * @param PassData  The pass to filter.
+ */
+void UFixedBeingsManagerEditorSubsystem::FilterPassToRegion(FPlacementPass& PassData) const
+{
+	const float   Density = TerrainManager->GetDensity();
+	const float   Margin = MaxSurfaceDisplacement * Density + 1.f;
+	const FBox2D  GridRegion(PlacementRegion->Min * Density - Margin, PlacementRegion->Max * Density + Margin);
+	const bool    bSampled = PassData.Samples.Num() == PassData.Candidates.Num();
+
+	int32 Kept = 0;
+	int32 Candidate = 0;
+	for(int32 Row = 0; Row < PassData.RowEnds.Num(); Row++)
+	{
+		for(; Candidate < PassData.RowEnds[Row]; Candidate++)
+		{
+			if(!GridRegion.IsInside(PassData.Candidates[Candidate]))
+			{
+				continue;
+			}
+			PassData.Candidates[Kept] = PassData.Candidates[Candidate];
+			PassData.Keys[Kept] = PassData.Keys[Candidate];
+			if(bSampled)
+			{
+				PassData.Samples[Kept] = PassData.Samples[Candidate];
+			}
+			Kept++;
+		}
+		PassData.RowEnds[Row] = Kept;
+	}
+
+	PassData.Candidates.SetNum(Kept);
+	PassData.Keys.SetNum(Kept);
+	PassData.Samples.SetNum(bSampled ? Kept : 0);
+}
+
+// Snapshots
+
+/**
+ * @brief Writes what is placed right now into a snapshot.
+ *
+ * The records are made from the spawned beings themselves rather than PlacementRecords, so the beings of a reopened level
+ * or of a class that is no longer listed are in it too. Such a class is added to the classes of the snapshot.
+ * Call CheckChildren first so the beings attached to the environment are all spawned beings.
+ *
+ * @param Snapshot  The snapshot to overwrite.
+ */
+void UFixedBeingsManagerEditorSubsystem::TakeSnapshot(UFixedBeingsSnapshot& Snapshot) const
+{
+	Snapshot.Classes = FixedBeingsClasses;
+	Snapshot.bInstanced = Parameters.bInstanced;
+	Snapshot.Records.Reset(SpawnedBeings.Num());
+
+	for(const FSpawnedBeing& SpawnedBeing : SpawnedBeings)
+	{
+		UClass* Class = SpawnedBeing.Class;
+		if(!Class)
+		{
+			continue;
+		}
+		int32 ClassIndex = Snapshot.Classes.IndexOfByPredicate([Class](TSubclassOf<AFixedBeing> const& Listed) {
+			return Listed && Class->IsChildOf(Listed);
+		});
+		if(ClassIndex == INDEX_NONE)
+		{
+			ClassIndex = Snapshot.Classes.Add(Class);
+		}
+
+		FPlacementRecord Record;
+		if(MakePlacementRecord(SpawnedBeing, ClassIndex, Record))
+		{
+			Snapshot.Records.Add(Record);
+		}
+	}
+}
+
+/**
+ * @brief Puts the placement of a snapshot back in place of whatever is placed now, without recording it for undo.
+ *
+ * @param Snapshot  The placement to put back.
+ * @param Parent  The actor the beings are placed under.
+ */
+void UFixedBeingsManagerEditorSubsystem::RestorePlacement(UFixedBeingsSnapshot const& Snapshot, AActor* Parent)
+{
+	const FScopedBulkEdit BulkEdit;
+
+	SetFixedBeingsClasses(Snapshot.Classes);
+	Parameters.bInstanced = Snapshot.bInstanced;
+
+	CheckChildren(Parent);
+	DespawnToPicker();
+	RebuildSpatialIndex();
+	ApplyPlacementRecords(Snapshot.Records, Parent);
+
+	ClearPicker();
+}
+
+// Rasters
+
+/**
+ * @brief Rebuilds the placement rasters if the terrain surface changed since they were built.
+ *
+ * @return false if there is no surface to build them from.
+ */
+bool UFixedBeingsManagerEditorSubsystem::UpdateRasters()
+{
+	if(!TerrainManager || TerrainManager->GetSurface().IsEmpty())
+	{
+		UE_LOG(LogTemp, Error, TEXT("FBManager: No terrain surface to build the placement rasters from"));
+		Rasters.Reset();
+		return false;
+	}
+	if(Rasters.IsBuilt() && RastersSurfaceVersion == TerrainManager->GetSurfaceVersion())
+	{
+		return true;
+	}
+
+	Rasters.Build(TerrainManager->GetSurface(), TerrainManager->MinZ, TerrainManager->MaxZ);
+	RastersSurfaceVersion = TerrainManager->GetSurfaceVersion();
+
+	MaxSurfaceDisplacement = 0.f;
+	for(const FVector2f& Displacement : TerrainManager->GetSurface().Displacements)
+	{
+		MaxSurfaceDisplacement = FMath::Max(MaxSurfaceDisplacement, Displacement.Size());
+	}
+	return Rasters.IsBuilt();
+}
+
+/**
+ * @brief Writes the placement rasters of the current terrain as bitmaps, building them first if needed.
+ *
+ * @return false if there is no terrain or a bitmap could not be written.
+ */
+bool UFixedBeingsManagerEditorSubsystem::ExportPlacementRasters()
+{
+	if(!TerrainManager)
+	{
+		TerrainManager = GEditor->GetEditorSubsystem<UTerrainManagerEditorSubsystem>();
+	}
+	if(!TerrainManager || !TerrainManager->IsOk() || !UpdateRasters())
+	{
+		return false;
+	}
+	return Rasters.ExportDebugBitmaps(FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("PlacementRasters")));
+}
+
+// Placement
+
+void UFixedBeingsManagerEditorSubsystem::RedistributeFixedBeings(FFixedBeingsParameters                  NewParameters, AActor* Parent,
+                                                                 TArray<TSubclassOf<AFixedBeing>> const& NewClasses)
+
+{
+	// thousands of actors are spawned, moved and attached below, the caller keeps a snapshot for undo instead
+	const FScopedBulkEdit BulkEdit(bBulkEdit);
+
+	// check if classes are the same
+	bool bFound = false;
+	for(auto& NewClass : NewClasses)
+	{
+		for(auto& OldClass : FixedBeingsClasses)
+		{
+			if(NewClass == OldClass)
+			{
+				bFound = true;
+				break;
+			}
+		}
+	}
+	for(auto& OldClass : FixedBeingsClasses)
+	{
+		for(auto& NewClass : NewClasses)
+		{
+			if(OldClass == NewClass)
+			{
+				bFound = true;
+				break;
+			}
+		}
+	}
+	if(!bFound)
+	{
+		FixedBeingsClasses = NewClasses;
+		bDirty = true;
+	}
+
+	Parameters = NewParameters;
+
+	if(!TerrainManager)
+	{
+		TerrainManager = GEditor->GetEditorSubsystem<UTerrainManagerEditorSubsystem>();
+	}
+
+	if(!TerrainManager || !TerrainManager->IsOk())
+	{
+		UE_LOG(LogTemp, Error, TEXT("FBManager: Terrain Manager is not set or not properly initialized"));
+		return;
+	}
+
+	if(FixedBeingsClasses.Num() == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("FBManager: No Fixed Beings Classes to be placed"));
+		return;
+	}
+
+	const int32 NumberOfPasses = Parameters.Placement == EFixedBeingPlacement::PoissonDisk ? 1 : Parameters.FixedBeingPlacingPasses;
+	const float NumberOfTasks =
+	+1 // Fixed Beings Preparation
+	+ 1 // Fixed Beings Placement Begin
+	+ NumberOfPasses * TerrainManager->NumOfXVertices * TerrainManager->NumOfYVertices // Fixed Beings Placement
+	;
+	FScopedSlowTask Progress(NumberOfTasks, FText::FromString("Redistributing Fixed Beings"));
+	// commandlets run headless, the progress only goes to the log there
+	if(!IsRunningCommandlet())
+	{
+		Progress.MakeDialog(true, true);
+	}
+
+	Progress.EnterProgressFrame(1.f, FText::FromString(FString::Printf(TEXT("Preparing Fixed Beings..."))));
+
+	if(Progress.ShouldCancel())
+	{
+		return;
+	}
+
+	DespawnToPicker();
+	RebuildSpatialIndex();
+	PlacementRecords.Reset();
+	PassTimings.Reset();
+
+	// The same terrain, parameters, seed and classes always place the same beings, so a cached placement is put back as it was
+	const FString            CacheKey = bUseDiskCache ? GetPlacementCacheKey() : FString();
+	TArray<FPlacementRecord> CachedRecords;
+	if(!CacheKey.IsEmpty() && LoadPlacementCache(CacheKey, CachedRecords))
+	{
+		ApplyPlacementRecords(CachedRecords, Parent);
+	}
+	else if(UpdateRasters())
+	{
+		bool bCompleted = true;
+		if(Parameters.Placement == EFixedBeingPlacement::PoissonDisk)
+		{
+			FScopedDurationTimer Timer(PassTimings.AddZeroed_GetRef());
+			bCompleted = PlacePoissonDisk(Progress, Parent);
+		}
+		else
+		{
+			for(int32 i = 1; i <= Parameters.FixedBeingPlacingPasses && bCompleted; i++)
+			{
+				FScopedDurationTimer Timer(PassTimings.AddZeroed_GetRef());
+				bCompleted = PlaceFixedBeingsPass(i, Progress, Parent);
+			}
+		}
+
+		if(bCompleted && !CacheKey.IsEmpty())
+		{
+			SavePlacementCache(CacheKey);
+		}
+	}
+
+	ClearPicker();
+	bDirty = false;
+}
+
+/**
+ * Walk the candidates of a pass. The steps do not depend on what gets placed, so a whole pass can be walked before any of it is committed.
+ *
+ * @param Pass  The pass number.
+ * @param Precision  The placing precision, higher makes smaller steps.
+ * @param NumOfXVertices  The width of the terrain grid.
+ * @param NumOfYVertices  The height of the terrain grid.
+ * @param OutPass  The candidates, without samples.
+ */
+void UFixedBeingsManagerEditorSubsystem::WalkPass(const int32& Pass, const float Precision, const int32 NumOfXVertices, const int32 NumOfYVertices,
+                                                  FPlacementPass& OutPass) const
+{
+	OutPass.Pass = Pass;
+
+	// the step into a row or column is keyed by its index, the first one by -1
+	int32 Row = 0;
+	float y = GetDeterministicStep(Pass, NumOfYVertices, Precision, FIntPoint(-1, -1), EPlacementStream::YStep);
+
+	while(y < NumOfYVertices)
+	{
+		int32 Column = 0;
+		float x = GetDeterministicStep(Pass, NumOfXVertices, Precision, FIntPoint(-1, Row), EPlacementStream::XStep);
+
+		while(x < NumOfXVertices)
+		{
+			OutPass.Candidates.Add(FVector2D(x, y));
+			OutPass.Keys.Add(FIntPoint(Column, Row));
+
+			const float XAmount = GetDeterministicStep(Pass, NumOfXVertices, Precision, FIntPoint(Column, Row), EPlacementStream::XStep);
+			x += XAmount;
+			Column++;
+		}
+		const float YAmount = GetDeterministicStep(Pass, NumOfYVertices, Precision, FIntPoint(-1, Row), EPlacementStream::YStep);
+		y += YAmount;
+		Row++;
+
+		OutPass.RowEnds.Add(OutPass.Candidates.Num());
+		OutPass.RowSteps.Add(YAmount);
+	}
+}
+
+bool UFixedBeingsManagerEditorSubsystem::PlaceFixedBeingsPass(const int32& Pass, FScopedSlowTask& Progress, AActor* Parent)
+{
+
+	Progress.EnterProgressFrame(1.f, FText::FromString(FString::Printf(TEXT("Placing Fixed Beings Pass %d..."), Pass)));
+
+	if(Progress.ShouldCancel())
+	{
+		return false;
+	}
+
+	const int32 NumOfXVertices = TerrainManager->NumOfXVertices;
+	const int32 NumOfYVertices = TerrainManager->NumOfYVertices;
+
+	// The steps do not depend on what gets placed, so walk the whole pass first, the terrain is only sampled under the candidates the rasters let through
+	FPlacementPass PassData;
+	WalkPass(Pass, Parameters.FixedBeingPlacingPrecision, NumOfXVertices, NumOfYVertices, PassData);
+	if(PlacementRegion.IsSet())
+	{
+		FilterPassToRegion(PassData);
+	}
+	return CommitPass(PassData, Progress, Parent);
+}
+
+/**
+ * Place the fixed beings in a single Poisson disk sweep instead of the stepped passes.
+ * The candidates already keep the smallest spacing between them, so there are far fewer of them to sample and check,
+ * the affinities and the spacing of the classes that need more room are applied when they are committed as usual.
+ */
+bool UFixedBeingsManagerEditorSubsystem::PlacePoissonDisk(FScopedSlowTask& Progress, AActor* Parent)
+{
+	Progress.EnterProgressFrame(1.f, FText::FromString(TEXT("Placing Fixed Beings...")));
+
+	if(Progress.ShouldCancel())
+	{
+		return false;
+	}
+
+	FPlacementPass PassData;
+	WalkPoissonDisk(TerrainManager->NumOfXVertices, TerrainManager->NumOfYVertices, PassData);
+	if(PlacementRegion.IsSet())
+	{
+		FilterPassToRegion(PassData);
+	}
+	return CommitPass(PassData, Progress, Parent);
+}
+
+/**
+ * Bridson's Poisson disk sampling over the terrain grid.
+ * The radius is the smallest MinimumSpacing of the classes, but never finer than the last of the stepped passes would sample.
+ * Candidates come out in the order they were generated, in rows of a fixed size for the progress.
+ *
+ * @param NumOfXVertices  The width of the terrain grid.
+ * @param NumOfYVertices  The height of the terrain grid.
+ * @param OutPass  The candidates, without samples.
+ */
+void UFixedBeingsManagerEditorSubsystem::WalkPoissonDisk(const int32 NumOfXVertices, const int32 NumOfYVertices, FPlacementPass& OutPass) const
+{
+	OutPass.Pass = 1;
+
+	const float Width = NumOfXVertices - 1;
+	const float Height = NumOfYVertices - 1;
+	if(Width <= 0 || Height <= 0)
+	{
+		return;
+	}
+
+	float MinimumSpacing = TNumericLimits<float>::Max();
+	for(auto& Class : FixedBeingsClasses)
+	{
+		if(const AFixedBeing* Default = Class ? Class->GetDefaultObject<AFixedBeing>() : nullptr)
+		{
+			MinimumSpacing = FMath::Min(MinimumSpacing, Default->MinimumSpacing);
+		}
+	}
+	if(MinimumSpacing == TNumericLimits<float>::Max())
+	{
+		MinimumSpacing = 0.f;
+	}
+
+	// in vertices, bounded below by the finest pass and by the size of the background grid
+	constexpr float MaxNumOfCells = 1 << 24;
+	const float     FinestStep = FMath::Max(Width, Height) / (FMath::Max(Parameters.FixedBeingPlacingPasses, 1) * Parameters.FixedBeingPlacingPrecision);
+	const float     Radius = FMath::Max3(MinimumSpacing * TerrainManager->GetDensity(), FinestStep, FMath::Sqrt(2.f * Width * Height / MaxNumOfCells));
+	const float     RadiusSquared = FMath::Square(Radius);
+
+	// at most one candidate per cell
+	const float CellSize = Radius / UE_SQRT_2;
+	const int32 NumOfXCells = FMath::CeilToInt32(Width / CellSize) + 1;
+	const int32 NumOfYCells = FMath::CeilToInt32(Height / CellSize) + 1;
+	TArray<int32> Cells;
+	Cells.Init(INDEX_NONE, NumOfXCells * NumOfYCells);
+
+	auto GetCell = [&](FVector2D const& Point)
+	{
+		return FIntPoint(FMath::Min(FMath::FloorToInt32(Point.X / CellSize), NumOfXCells - 1), FMath::Min(FMath::FloorToInt32(Point.Y / CellSize), NumOfYCells - 1));
+	};
+	auto IsFree = [&](FVector2D const& Point)
+	{
+		const FIntPoint Cell = GetCell(Point);
+		for(int32 Y = FMath::Max(Cell.Y - 2, 0); Y <= FMath::Min(Cell.Y + 2, NumOfYCells - 1); Y++)
+		{
+			for(int32 X = FMath::Max(Cell.X - 2, 0); X <= FMath::Min(Cell.X + 2, NumOfXCells - 1); X++)
+			{
+				const int32 Other = Cells[Y * NumOfXCells + X];
+				if(Other != INDEX_NONE && FVector2D::DistSquared(OutPass.Candidates[Other], Point) < RadiusSquared)
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	};
+
+	TArray<int32> Active;
+	auto Add = [&](FVector2D const& Point)
+	{
+		const int32     Index = OutPass.Candidates.Add(Point);
+		const FIntPoint Cell = GetCell(Point);
+		OutPass.Keys.Add(FIntPoint(Index, 0));
+		Cells[Cell.Y * NumOfXCells + Cell.X] = Index;
+		Active.Add(Index);
+	};
+
+	Add(FVector2D(
+		GetDetRand0To1(OutPass.Pass, FIntPoint(-1, 0), EPlacementStream::PoissonStart) * Width,
+		GetDetRand0To1(OutPass.Pass, FIntPoint(-1, 1), EPlacementStream::PoissonStart) * Height));
+
+	constexpr int32 NumOfAttempts = 30;
+	for(int32 Step = 0; Active.Num() > 0; Step++)
+	{
+		const float     ActiveRandom = GetDetRand0To1(OutPass.Pass, FIntPoint(Step, -1), EPlacementStream::PoissonActive);
+		const int32     ActiveIndex = FMath::Min(FMath::FloorToInt32(ActiveRandom * Active.Num()), Active.Num() - 1);
+		const FVector2D Centre = OutPass.Candidates[Active[ActiveIndex]];
+
+		bool bFound = false;
+		for(int32 Attempt = 0; Attempt < NumOfAttempts && !bFound; Attempt++)
+		{
+			// uniform in the annulus between one and two radii
+			const float     Angle = GetDetRand0To1(OutPass.Pass, FIntPoint(Step, Attempt), EPlacementStream::PoissonAngle) * UE_TWO_PI;
+			const float     Distance = Radius * (1.f + GetDetRand0To1(OutPass.Pass, FIntPoint(Step, Attempt), EPlacementStream::PoissonDistance));
+			const FVector2D Point = Centre + FVector2D(FMath::Cos(Angle), FMath::Sin(Angle)) * Distance;
+			if(Point.X < 0 || Point.Y < 0 || Point.X > Width || Point.Y > Height || !IsFree(Point))
+			{
+				continue;
+			}
+			Add(Point);
+			bFound = true;
+		}
+		if(!bFound)
+		{
+			Active.RemoveAtSwap(ActiveIndex);
+		}
+	}
+
+	// rows only drive the progress here
+	constexpr int32 RowSize = 1024;
+	for(int32 RowEnd = RowSize; RowEnd < OutPass.Candidates.Num() + RowSize; RowEnd += RowSize)
+	{
+		const int32 End = FMath::Min(RowEnd, OutPass.Candidates.Num());
+		OutPass.RowSteps.Add(static_cast<float>(NumOfYVertices) * (End - (RowEnd - RowSize)) / OutPass.Candidates.Num());
+		OutPass.RowEnds.Add(End);
+	}
+}
+
+/**
+ * Evaluate the candidates of a pass in parallel, then commit them in order.
+ *
+ * @param PassData  The candidates and their samples.
+ * @param Progress  Advanced row by row.
+ * @param Parent  The actor the beings are placed under.
+ * @return false if it was cancelled, everything placed is cleared then
+ */
+bool UFixedBeingsManagerEditorSubsystem::CommitPass(FPlacementPass& PassData, FScopedSlowTask& Progress, AActor* Parent)
+{
+	const int32              Pass = PassData.Pass;
+	const int32              NumOfXVertices = TerrainManager->NumOfXVertices;
+	const TArray<FVector2D>& Candidates = PassData.Candidates;
+	const TArray<FIntPoint>& Keys = PassData.Keys;
+	TArray<FTerrainSample>&  Samples = PassData.Samples;
+	const TArray<int32>&     RowEnds = PassData.RowEnds;
+	const TArray<float>&     RowSteps = PassData.RowSteps;
+
+	// filled in as the candidates get past the rasters
+	if(Samples.Num() != Candidates.Num())
+	{
+		Samples.Reset();
+		Samples.SetNum(Candidates.Num());
+	}
+
+	// Every candidate draws its class from its own key, so it is evaluated in parallel
+	// against the beings of the earlier passes with the rules of the being at the front of the picker
+	ReservePicker({});
+	auto& Picker = GetPicker();
+	TArray<FFixedBeingRules> PickerRules;
+	PickerRules.SetNum(Picker.Num());
+	for(int32 i = 0; i < Picker.Num(); i++)
+	{
+		if(Picker[i].Num() > 0)
+		{
+			PickerRules[i] = Picker[i].Peek()->GetRules();
+		}
+	}
+	RuleTable.Build(PickerRules);
+	FrontRules = MoveTemp(PickerRules);
+	FrontMatchesTable.Init(true, FrontRules.Num());
+
+	TArray<FCandidateEvaluation> Evaluations;
+	Evaluations.SetNum(Candidates.Num());
+
+	constexpr int32 BatchSize = 256;
+	const int32     NumOfBatches = FMath::DivideAndRoundUp(Candidates.Num(), BatchSize);
+	ParallelFor(NumOfBatches, [&](const int32 Batch)
+	{
+		TArray<int32>     Nearby;
+		FRuleScoringBatch Scoring;
+		const int32       Begin = Batch * BatchSize;
+		EvaluateBatch(PassData, Begin, FMath::Min(Candidates.Num(), Begin + BatchSize), Scoring, Nearby, Evaluations);
+	});
+
+	// Only the candidates that are left can take a being, so the pool is filled for all of them up front
+	// and one more so the front of every bucket is still there to be compared against
+	TArray<int32> NumOfBeings;
+	NumOfBeings.Init(1, Picker.Num());
+	for(const FCandidateEvaluation& Evaluation : Evaluations)
+	{
+		if(!Evaluation.bRejected)
+		{
+			NumOfBeings[Evaluation.PickerIndex]++;
+		}
+	}
+	for(int32 i = 0; i < Picker.Num(); i++)
+	{
+		if(CanBeInstanced(Picker[i].Peek()))
+		{
+			NumOfBeings[i] = 1;
+		}
+	}
+	ReservePicker(NumOfBeings);
+
+	// Then committed in order, only checking against what this pass has placed so far
+	const int32 PassBegin = SpawnedBeings.Num();
+
+	int32 Candidate = 0;
+	for(int32 Row = 0; Row < RowEnds.Num(); Row++)
+	{
+		for(; Candidate < RowEnds[Row]; Candidate++)
+		{
+			PlaceFixedBeingInEnvironment(Pass, Candidates[Candidate].Y, Candidates[Candidate].X, Keys[Candidate], Samples[Candidate], Evaluations[Candidate],
+			                             Parent);
+
+			if(Progress.ShouldCancel())
+			{
+				ClearAll();
+				return false;
+			}
+		}
+
+		Progress.EnterProgressFrame(RowSteps[Row] * NumOfXVertices, FText::FromString(FString::Printf(TEXT("Placing Fixed Beings Pass %d..."), Pass)));
+
+		if(Progress.ShouldCancel())
+		{
+			ClearAll();
+			return false;
+		}
+	}
+
+	MergePassIndex(PassBegin);
+	FrontRules.Reset();
+	FrontMatchesTable.Empty();
+	return true;
+}
+
+/**
+ * Read the rules of the being that has just come to the front of a bucket, during a pass.
+ *
+ * @param PickerIndex  The bucket.
+ */
+void UFixedBeingsManagerEditorSubsystem::UpdatePickerFront(const int32 PickerIndex)
+{
+	if(!FrontRules.IsValidIndex(PickerIndex))
+	{
+		return;
+	}
+	const AFixedBeing* Front = GetPicker()[PickerIndex].Peek();
+	FrontRules[PickerIndex] = Front ? Front->GetRules() : FFixedBeingRules();
+	FrontMatchesTable[PickerIndex] = FrontRules[PickerIndex] == RuleTable.GetRules(PickerIndex);
+}
+
+/**
+ * Evaluate a run of candidates of a pass like EvaluateCandidate, with the rules read from RuleTable.
+ * The rasters and draws of the whole run are gathered first and scored by the table a vector at a time,
+ * only the candidates that get past them are sampled and checked against their neighbours.
+ * Safe to call from any thread while nothing is being placed.
+ *
+ * @param PassData  The pass, the samples of the candidates that are left are filled in.
+ * @param Begin  The first candidate of the run.
+ * @param End  One past the last candidate of the run.
+ * @param Scoring  Scratch space for the scoring.
+ * @param Nearby  Scratch space for the neighbour query.
+ * @param Evaluations  The evaluations of the whole pass, only the run is written.
+ */
+void UFixedBeingsManagerEditorSubsystem::EvaluateBatch(FPlacementPass& PassData, const int32 Begin, const int32 End, FRuleScoringBatch& Scoring,
+                                                       TArray<int32>& Nearby, TArray<FCandidateEvaluation>& Evaluations) const
+{
+	const int32 Pass = PassData.Pass;
+
+	Scoring.Reset(End - Begin);
+	for(int32 i = Begin; i < End; i++)
+	{
+		const int32            Lane = i - Begin;
+		const FIntPoint        Key = PassData.Keys[i];
+		FPlacementRasterSample Raster;
+		const bool             bOnTerrain = Rasters.Sample(PassData.Candidates[i].X, PassData.Candidates[i].Y, Raster);
+
+		Evaluations[i].PickerIndex = GetDeterministicPickerIndex(Pass, Key);
+		Scoring.RuleIndices[Lane] = Evaluations[i].PickerIndex;
+		Scoring.DepthPercentages[Lane] = Raster.DepthPercentage;
+		Scoring.Flatnesses[Lane] = Raster.Flatness;
+		Scoring.OnTerrain[Lane] = bOnTerrain ? 1.f : 0.f;
+		Scoring.UpsideDown[Lane] = Raster.bUpsideDown ? 1.f : 0.f;
+		Scoring.FrequencyDraws[Lane] = GetDetRand0To1(Pass, Key, EPlacementStream::Frequency);
+		Scoring.DepthDraws[Lane] = GetDetRand0To1(Pass, Key, EPlacementStream::Depth);
+		Scoring.SlopeDraws[Lane] = GetDetRand0To1(Pass, Key, EPlacementStream::Slope);
+	}
+
+	RuleTable.Score(Scoring);
+
+	for(int32 i = Begin; i < End; i++)
+	{
+		const int32           Lane = i - Begin;
+		FCandidateEvaluation& Evaluation = Evaluations[i];
+		Evaluation.bUpsideDown = Scoring.UpsideDown[Lane] > 0.5f;
+		Evaluation.SkewedDepthAffinity = Scoring.SkewedDepthAffinities[Lane];
+		Evaluation.SkewedFlatnessAffinity = Scoring.SkewedFlatnessAffinities[Lane];
+		Evaluation.bRejected = true;
+
+		if(Scoring.Accepted[Lane])
+		{
+			FinishEvaluation(PassData.Candidates[i], PassData.Samples[i], RuleTable.GetRules(Evaluation.PickerIndex), Nearby, Evaluation);
+		}
+	}
+}
+
+/**
+ * Evaluate the parts of a candidate that only depend on the terrain under it, its rules, its draws and the beings of the earlier passes.
+ * The draws are tested against the rasters, the terrain is only sampled for the candidates that get past them.
+ * The scalar counterpart of EvaluateBatch, for a candidate whose being changed after its pass was scored.
+ * Safe to call from any thread while nothing is being placed.
+ *
+ * @param Pass  The pass the candidate belongs to.
+ * @param Key  The column and row of the candidate in its pass.
+ * @param Candidate  The candidate in vertices.
+ * @param InOutSample  The terrain under the candidate, sampled here if it is needed and not valid yet.
+ * @param Rules  The rules of the being the candidate would place.
+ * @param Nearby  Scratch space for the neighbour query.
+ * @param OutEvaluation  The affinities, whether the candidate is already rejected, and the cluster scores against SpatialIndex.
+ */
+void UFixedBeingsManagerEditorSubsystem::EvaluateCandidate(const int32& Pass, FIntPoint const Key, FVector2D const& Candidate,
+                                                           FTerrainSample& InOutSample, FFixedBeingRules const& Rules, TArray<int32>& Nearby,
+                                                           FCandidateEvaluation& OutEvaluation) const
+{
+	FPlacementRasterSample Raster;
+	const bool             bOnTerrain = Rasters.Sample(Candidate.X, Candidate.Y, Raster);
+
+	OutEvaluation.bUpsideDown = Raster.bUpsideDown;
+	OutEvaluation.SkewedDepthAffinity = FMath::Lerp(Rules.ShallowAffinity, Rules.DeepAffinity, Raster.DepthPercentage);
+	OutEvaluation.SkewedFlatnessAffinity = FMath::Lerp(Rules.VerticalAffinity, Rules.FlatAffinity, Raster.Flatness);
+	OutEvaluation.bRejected = true;
+
+	// rejected before the neighbours matter
+	if(!bOnTerrain || !Rules.Class || !Rules.bIsSpawnable) return;
+	if(GetDetRand0To1(Pass, Key, EPlacementStream::Frequency) > Rules.Frequency) return;
+
+	// Is upside down
+	if(!Rules.bCanBeUpsideDown && OutEvaluation.bUpsideDown) return;
+
+	// Depth affinity
+	if(GetDetRand0To1(Pass, Key, EPlacementStream::Depth) > OutEvaluation.SkewedDepthAffinity) return;
+
+	// Slope affinity
+	if(GetDetRand0To1(Pass, Key, EPlacementStream::Slope) > OutEvaluation.SkewedFlatnessAffinity) return;
+
+	FinishEvaluation(Candidate, InOutSample, Rules, Nearby, OutEvaluation);
+}
+
+/**
+ * Sample the terrain under a candidate that got past its rules and draws, and check it against the beings of the earlier passes.
+ *
+ * @param Candidate  The candidate in vertices.
+ * @param InOutSample  The terrain under the candidate, sampled here if it is not valid yet.
+ * @param Rules  The rules of the being the candidate would place.
+ * @param Nearby  Scratch space for the neighbour query.
+ * @param OutEvaluation  Whether the candidate is rejected and its cluster scores against SpatialIndex.
+ */
+void UFixedBeingsManagerEditorSubsystem::FinishEvaluation(FVector2D const& Candidate, FTerrainSample& InOutSample, FFixedBeingRules const& Rules,
+                                                          TArray<int32>& Nearby, FCandidateEvaluation& OutEvaluation) const
+{
+	OutEvaluation.Scores = FClusterScores();
+	OutEvaluation.Scores.SelfPositive = 1.f - Rules.SelfClusterAfinity;
+	OutEvaluation.Scores.OthersPositive = 1.f - Rules.OthersClusterAfinity;
+	OutEvaluation.bRejected = true;
+
+	if(!InOutSample.bValid)
+	{
+		InOutSample = TerrainManager->SampleSurface(Candidate.X, Candidate.Y);
+		if(!InOutSample.bValid) return;
+	}
+
+	// Only what lands in the region is placed, the beings around it are in SpatialIndex like any other
+	if(PlacementRegion.IsSet() && !PlacementRegion->IsInside(FVector2D(InOutSample.Position))) return;
+
+	OutEvaluation.bRejected = !AccumulateNearby(SpatialIndex, InOutSample.Position, Rules, Nearby, OutEvaluation.Scores);
+}
+
+/**
+ * Check the spacing against the beings in an index and add them to the cluster scores.
+ *
+ * @param Index  The beings to check against.
+ * @param Location  The candidate location.
+ * @param Rules  The rules of the being the candidate would place.
+ * @param Nearby  Scratch space for the neighbour query.
+ * @param InOutScores  The scores to add to, in the order the beings were spawned in.
+ * @return false if the candidate is closer than the minimum spacing to one of the beings, the scores are left partial then
+ */
+bool UFixedBeingsManagerEditorSubsystem::AccumulateNearby(FFixedBeingSpatialIndex const& Index, FVector const& Location, FFixedBeingRules const& Rules,
+                                                          TArray<int32>& Nearby, FClusterScores& InOutScores) const
+{
+	// Only the beings within reach of either check matter, in the order they were spawned in so the scores add up the same way
+	const float QueryRadius = FMath::Max3(Parameters.ClusterRange, Rules.MinimumSpacing, Index.GetMaxMinimumSpacing());
+	Index.Gather(Location, QueryRadius, Nearby);
+
+	// Any spacing violation rejects the candidate, so look for one before weighing the clusters
+	for(const int32 Other : Nearby)
+	{
+		const FSpawnedBeing& OtherBeing = SpawnedBeings[Other];
+		if(!OtherBeing.IsValid()) continue;
+		const float Spacing = FMath::Max(Rules.MinimumSpacing, OtherBeing.MinimumSpacing);
+		if(FVector::DistSquared(Location, OtherBeing.Location) <= FMath::Square(Spacing) * (1.f + UE_KINDA_SMALL_NUMBER)
+			&& FVector::Distance(Location, OtherBeing.Location) < Spacing)
+		{
+			return false;
+		}
+	}
+
+	for(const int32 Other : Nearby)
+	{
+		const FSpawnedBeing& OtherBeing = SpawnedBeings[Other];
+		if(!OtherBeing.IsValid()) continue;
+		const float Distance = FVector::Distance(Location, OtherBeing.Location);
+
+		if(Distance < Parameters.ClusterRange)
+		{
+
+			const float Weight = FMath::Clamp(1.0f - (Distance - Rules.MinimumSpacing) / Parameters.ClusterRange, 0.0f, 1.0f);
+
+			if(OtherBeing.Class == Rules.Class)
+			{
+				InOutScores.SelfNearbyCount++;
+				InOutScores.SelfNegative -= Weight * (Rules.SelfClusterAversion);
+				InOutScores.SelfPositive += Weight * (Rules.SelfClusterAfinity);
+			}
+			else
+			{
+				InOutScores.OthersNearbyCount++;
+				InOutScores.OthersNegative -= Weight * (Rules.OthersClusterAversion);
+				InOutScores.OthersPositive += Weight * (Rules.OthersClusterAfinity);
+			}
+
+		}
+	}
+	return true;
+}
+
+void UFixedBeingsManagerEditorSubsystem::PlaceFixedBeingInEnvironment(const int32& Pass, float const Y, float const X, FIntPoint const Key,
+                                                                      FTerrainSample& Sample, FCandidateEvaluation& Evaluation, AActor* Parent)
+{
+	auto& Picker = GetPicker();
+
+	const int32 CurrentPickerIndex = Evaluation.PickerIndex;
+	// ReservePicker fills every bucket for all the candidates that are left before any is placed
+	if(!ensureMsgf(Picker[CurrentPickerIndex].Num() > 0, TEXT("FBManager: Picker bucket %d is empty"), CurrentPickerIndex))
+	{
+		return;
+	}
+
+	AFixedBeing* FixedBeing = Picker[CurrentPickerIndex].Peek();
+
+	// The front of the picker moves as beings are placed, a being with different rules has to be evaluated again
+	const FFixedBeingRules& Rules = FrontRules[CurrentPickerIndex];
+	if(!FrontMatchesTable[CurrentPickerIndex])
+	{
+		EvaluateCandidate(Pass, Key, FVector2D(X, Y), Sample, Rules, NearbyBeings, Evaluation);
+	}
+
+	// Rules, draws and spacing to the earlier passes
+	if(Evaluation.bRejected) return;
+
+	const FVector Normal = Sample.Normal;
+	const FVector Location = Sample.Position;
+
+	const float SkewedDepthAffinity = Evaluation.SkewedDepthAffinity;
+	const float SkewedFlatnessAffinity = Evaluation.SkewedFlatnessAffinity;
+
+	// Clustering affinity, the earlier passes are already in the scores
+
+	FClusterScores Scores = Evaluation.Scores;
+	if(!AccumulateNearby(PassIndex, Location, Rules, NearbyBeings, Scores)) return;
+
+	const float SelfClusterPositiveScore = Scores.SelfPositive;
+	const float SelfClusterNegativeScore = Scores.SelfNegative;
+	const float OthersClusterPositiveScore = Scores.OthersPositive;
+	const float OthersClusterNegativeScore = Scores.OthersNegative;
+	const int   SelfNearbyCount = Scores.SelfNearbyCount;
+	const int   OthersNearbyCount = Scores.OthersNearbyCount;
+
+	if(GetDetRand0To1(Pass, Key, EPlacementStream::SelfClusterNegative) > SelfClusterNegativeScore) return;
+	if(GetDetRand0To1(Pass, Key, EPlacementStream::SelfClusterPositive) > SelfClusterPositiveScore) return;
+	if(GetDetRand0To1(Pass, Key, EPlacementStream::OthersClusterNegative) > OthersClusterNegativeScore) return;
+	if(GetDetRand0To1(Pass, Key, EPlacementStream::OthersClusterPositive) > OthersClusterPositiveScore) return;
+
+
+	// store audit info
+	FFixedBeingPlacement Placement;
+	Placement.ItemNumber = X * Y;
+	Placement.SkewedDepthAffinity = SkewedDepthAffinity;
+	Placement.SkewedFlatnessAffinity = SkewedFlatnessAffinity;
+	Placement.SelfClusterPositiveScore = SelfClusterPositiveScore;
+	Placement.SelfClusterNegativeScore = SelfClusterNegativeScore;
+	Placement.OthersClusterPositiveScore = OthersClusterPositiveScore;
+	Placement.OthersClusterNegativeScore = OthersClusterNegativeScore;
+	Placement.PlacementPass = Pass;
+	Placement.NumberOfBeingsWhenPlaced = SpawnedBeings.Num();
+	Placement.NumberOfBeingsNearby = SelfNearbyCount + OthersNearbyCount;
+	Placement.NumberOfOtherBeingsNearby = OthersNearbyCount;
+	Placement.NumberOfSameBeingsNearby = SelfNearbyCount;
+	Placement.ClusterRadius = Parameters.ClusterRange;
+
+	// place the being
+	FQuat       Rotation;
+	const float RandomRotation = GetDetRand0To1(Pass, Key, EPlacementStream::Rotation) * 360.0f;
+
+	if(FixedBeing->bAlwaysPointUp)
+	{
+		// Up but random rotation
+		Rotation = FQuat(FRotator(0, RandomRotation, 0));
+	}
+	else
+	{
+		// Rotate to match normal
+		const FQuat FromUpToNormal = FQuat::FindBetweenNormals(FVector::UpVector, Normal);
+
+		// Apply a random rotation around the normal axis
+		const FQuat AroundNormal = FQuat(Normal, FMath::DegreesToRadians(RandomRotation));
+
+		// Combine the rotations
+		Rotation = AroundNormal * FromUpToNormal;
+	}
+
+	SpawnFixedBeing(CurrentPickerIndex, Location, Rotation, Placement, Parent);
+}
+
+/**
+ * @brief Puts the being at the front of a picker bucket into the environment and records it for the placement cache.
+ *
+ * @param PickerIndex  The bucket, the index of the class in FixedBeingsClasses.
+ * @param Location  Where the being goes, relative to the parent.
+ * @param Rotation  How the being is oriented, relative to the parent.
+ * @param Placement  The audit info of the being.
+ * @param Parent  The actor the being is placed under.
+ */
+void UFixedBeingsManagerEditorSubsystem::SpawnFixedBeing(const int32 PickerIndex, FVector const& Location, FQuat const& Rotation,
+                                                         FFixedBeingPlacement const& Placement, AActor* Parent)
+{
+	auto& Picker = GetPicker();
+	if(Picker[PickerIndex].Num() == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("FBManager: Picker is empty"));
+		return;
+	}
+	AFixedBeing* FixedBeing = Picker[PickerIndex].Peek();
+
+	FPlacementRecord Record;
+	Record.ClassIndex = PickerIndex;
+	Record.Location = FVector3f(Location);
+	Record.Rotation = FQuat4f(Rotation);
+	Record.Placement = Placement;
+	PlacementRecords.Add(Record);
+
+	// The picker being only lends its class, mesh and rules to the instance and stays in the picker
+	if(CanBeInstanced(FixedBeing))
+	{
+		if(auto const Instances = GetInstances(FixedBeing, Parent))
+		{
+			FSpawnedBeing Spawned;
+			Spawned.Location = Location;
+			Spawned.Instances = Instances;
+			Spawned.InstanceIndex = Instances->AddBeing(FTransform(Rotation, Location, FixedBeing->GetActorScale3D()), Placement);
+			Spawned.Class = FixedBeing->GetClass();
+			Spawned.MinimumSpacing = FixedBeing->MinimumSpacing;
+			const int32 SpawnedIndex = AddSpawnedBeing(Spawned);
+			PassIndex.Add(SpawnedIndex, Location, Spawned.MinimumSpacing);
+			return;
+		}
+	}
+
+	FixedBeing->Placement = Placement;
+
+	// Move FixedBeing to the correct location and rotation
+	FixedBeing->SetActorLocationAndRotation(Location, Rotation);
+
+
+	// unHide the actor
+	FixedBeing->SetActorHiddenInGame(false);
+
+	// Enable collision
+	FixedBeing->SetActorEnableCollision(true);
+
+	FixedBeing->SetActorTickEnabled(true);
+
+	FixedBeing->AttachToActor(Parent, FAttachmentTransformRules::KeepRelativeTransform);
+
+	// remove from picker, add to FixedBeings
+	Picker[PickerIndex].Pop();
+	UpdatePickerFront(PickerIndex);
+	const int32 SpawnedIndex = AddSpawnedBeing(MakeSpawnedBeing(FixedBeing, Location));
+	PassIndex.Add(SpawnedIndex, Location, FixedBeing->MinimumSpacing);
+}
+
+/**
+ * @brief Finds the instance component of the class of a being on the parent, creating it the first time.
+ *
+ * @param Template  A being of the class, the mesh of the instances is taken from it.
+ * @param Parent  The actor the instances are placed under.
+ * @return The component, or nullptr if the being has no static mesh to instance.
+ */
+UFixedBeingInstancesComponent* UFixedBeingsManagerEditorSubsystem::GetInstances(AFixedBeing const* Template, AActor* Parent)
+{
+	const UClass* Class = Template->GetClass();
+	for(auto& WComponent : InstanceComponents)
+	{
+		auto Component = WComponent.Get();
+		if(Component && Component->BeingClass == Class && Component->GetOwner() == Parent)
+		{
+			return Component;
+		}
+	}
+
+	const UStaticMeshComponent* Mesh = Template->FindComponentByClass<UStaticMeshComponent>();
+	if(!Mesh || !Mesh->GetStaticMesh())
+	{
+		return nullptr;
+	}
+
+	const FName Name = MakeUniqueObjectName(Parent, UFixedBeingInstancesComponent::StaticClass(), FName(Class->GetName() + TEXT("_Instances")));
+	auto const  Component = NewObject<UFixedBeingInstancesComponent>(Parent, Name, RF_Transactional);
+	Component->BeingClass = Template->GetClass();
+	Component->SetTemplate(Template);
+	Component->SetupAttachment(Parent->GetRootComponent());
+	Parent->AddInstanceComponent(Component);
+	Component->RegisterComponent();
+
+	InstanceComponents.Add(Component);
+	return Component;
+}
+
+// Deterministic Random
+
+/**
+ * @brief Generates a deterministic random floating-point number between 0 and 1.
+ *
+ * @param Pass The current pass number.
+ * @param Key The column and row of the candidate in its pass.
+ * @param Stream The decision the number is drawn for.
+ *
+ * @return A pseudo-random float in [0, 1), the same for the same seed, pass, key and stream.
+ */
+float UFixedBeingsManagerEditorSubsystem::GetDetRand0To1(const int32& Pass, FIntPoint const Key, EPlacementStream const Stream) const
+{
+	return FPlacementRandom::Unit(Seed, Pass, Key, Stream);
+}
+
+/**
+ * @brief Computes a deterministic step to move the  placer.
+ *
+ * @param Pass The current pass number, affecting the step size calculation.
+ * @param ArraySize
+ * @param Precision The placing precision.
+ * @param Key The column and row the step is taken from.
+ * @param Stream XStep or YStep.
+ *
+ * @return The computed step size as an integer.
+ */
+float UFixedBeingsManagerEditorSubsystem::GetDeterministicStep(const int32& Pass, const int32 ArraySize, const float Precision, FIntPoint const Key,
+                                                               EPlacementStream const Stream) const
+{
+	const double RandomFrac = 0.1 + FPlacementRandom::Unit(Seed, Pass, Key, Stream);
+
+	// Precision will pull it down for smaller increments, Pass will also pull it down
+	return RandomFrac * (ArraySize / (Pass * Precision));
+}
+
+/**
+ * @brief Generates a deterministic index for selecting a fixed being class.
+ *
+ * @param Pass The current pass number.
+ * @param Key The column and row of the candidate in its pass.
+ *
+ * @return An integer representing the index of the fixed being class to be selected,
+ *         or 0 if there are no classes available.
+ */
+int32 UFixedBeingsManagerEditorSubsystem::GetDeterministicPickerIndex(const int32& Pass, FIntPoint const Key) const
+{
+	const int32 NumClasses = FixedBeingsClasses.Num();
+	if(NumClasses <= 0)
+	{
+		return 0;
+	}
+
+	return FMath::Min(FMath::FloorToInt32(FPlacementRandom::Unit(Seed, Pass, Key, EPlacementStream::Picker) * NumClasses), NumClasses - 1);
+}
+
+// Placement Cache
+
+/**
+ * Build the cache key of the placement about to run, a hash of everything the placed beings depend on:
+ * the terrain surface, the parameters, the seed, the classes with their default rules and the cache version.
+ *
+ * @return The key as a hex string, empty if the terrain cannot be identified
+ */
+FString UFixedBeingsManagerEditorSubsystem::GetPlacementCacheKey() const
+{
+	const FString& SurfaceKey = TerrainManager->GetSurfaceKey();
+	if(SurfaceKey.IsEmpty())
+	{
+		return FString();
+	}
+
+	FSHA1 Hash;
+	const auto Update = [&Hash](const auto& Value)
+	{
+		Hash.Update(reinterpret_cast<const uint8*>(&Value), sizeof(Value));
+	};
+	const auto UpdateString = [&Hash](FString const& Value)
+	{
+		Hash.UpdateWithString(*Value, Value.Len());
+	};
+
+	Update(PlacementCache::Version);
+	UpdateString(SurfaceKey);
+
+	Update(Parameters.FixedBeingPlacingPrecision);
+	Update(Parameters.FixedBeingPlacingPasses);
+	Update(Parameters.ClusterRange);
+	Update(Parameters.bInstanced);
+	Update(Parameters.Placement);
+	Update(Seed);
+
+	Update(FixedBeingsClasses.Num());
+	for(auto& Class : FixedBeingsClasses)
+	{
+		const AFixedBeing* Default = Class ? Class->GetDefaultObject<AFixedBeing>() : nullptr;
+		if(!Default)
+		{
+			return FString();
+		}
+		UpdateString(Class->GetPathName());
+
+		// field by field, the padding of the structs is not initialised
+		const FFixedBeingRules Rules = Default->GetRules();
+		Update(Rules.bIsSpawnable);
+		Update(Rules.Frequency);
+		Update(Rules.FlatAffinity);
+		Update(Rules.VerticalAffinity);
+		Update(Rules.DeepAffinity);
+		Update(Rules.ShallowAffinity);
+		Update(Rules.OthersClusterAversion);
+		Update(Rules.OthersClusterAfinity);
+		Update(Rules.SelfClusterAversion);
+		Update(Rules.SelfClusterAfinity);
+		Update(Rules.MinimumSpacing);
+		Update(Rules.bCanBeUpsideDown);
+		Update(Default->bAlwaysPointUp);
+		Update(Default->bNeedsActor);
+	}
+
+	Hash.Final();
+	FSHAHash Result;
+	Hash.GetHash(Result.Hash);
+	return Result.ToString();
+}
+
+FString UFixedBeingsManagerEditorSubsystem::GetPlacementCacheFilePath(FString const& Key) const
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("PlacementCache"), Key + TEXT(".placement"));
+}
+
+/**
+ * Read the placement records of the given key with a single read.
+ *
+ * @param Key  The cache key
+ * @param OutRecords  The records, in the order they were placed
+ * @return false if the file is missing or does not match the current classes
+ */
+bool UFixedBeingsManagerEditorSubsystem::LoadPlacementCache(FString const& Key, TArray<FPlacementRecord>& OutRecords) const
+{
+	TArray<uint8> Bytes;
+	if(!FFileHelper::LoadFileToArray(Bytes, *GetPlacementCacheFilePath(Key), FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Bytes);
+
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	Reader << Magic << Version;
+	if(Magic != PlacementCache::Magic || Version != PlacementCache::Version)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Ignoring invalid placement cache entry %s"), *Key);
+		return false;
+	}
+
+	Reader << OutRecords;
+	if(Reader.IsError() || !Reader.AtEnd())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Ignoring invalid placement cache entry %s"), *Key);
+		OutRecords.Empty();
+		return false;
+	}
+	for(const FPlacementRecord& Record : OutRecords)
+	{
+		if(!FixedBeingsClasses.IsValidIndex(Record.ClassIndex))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Ignoring invalid placement cache entry %s"), *Key);
+			OutRecords.Empty();
+			return false;
+		}
+	}
+
+	DiskCache::Touch(GetPlacementCacheFilePath(Key));
+	UE_LOG(LogTemp, Log, TEXT("Loaded %d fixed beings from placement cache %s"), OutRecords.Num(), *Key);
+	return true;
+}
+
+/**
+ * Write the records of the placement that just ran to the cache file of the given key.
+ * The least recently used placements are deleted once the cache outgrows PlacementCache::MaxBytes.
+ *
+ * @param Key  The cache key
+ */
+void UFixedBeingsManagerEditorSubsystem::SavePlacementCache(FString const& Key)
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+
+	uint32 Magic = PlacementCache::Magic;
+	uint32 Version = PlacementCache::Version;
+	Writer << Magic << Version << PlacementRecords;
+
+	const FString FilePath = GetPlacementCacheFilePath(Key);
+	if(!FFileHelper::SaveArrayToFile(Bytes, *FilePath))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Failed to write placement cache %s"), *Key);
+		return;
+	}
+	DiskCache::Prune(FPaths::GetPath(FilePath), TEXT(".placement"), PlacementCache::MaxBytes);
+}
+
+/**
+ * Put the beings of a cached placement back without evaluating anything.
+ *
+ * @param Records  The records to apply, in the order they were placed.
+ * @param Parent  The actor the beings are placed under.
+ */
+void UFixedBeingsManagerEditorSubsystem::ApplyPlacementRecords(TArray<FPlacementRecord> const& Records, AActor* Parent)
+{
+	// Every record is a placement, so the pool is filled for all of them before any is applied
+	auto&         Picker = GetPicker();
+	TArray<int32> NumOfBeings;
+	NumOfBeings.Init(1, Picker.Num());
+	for(const FPlacementRecord& Record : Records)
+	{
+		if(NumOfBeings.IsValidIndex(Record.ClassIndex))
+		{
+			NumOfBeings[Record.ClassIndex]++;
+		}
+	}
+	ReservePicker({});
+	for(int32 i = 0; i < Picker.Num(); i++)
+	{
+		if(CanBeInstanced(Picker[i].Peek()))
+		{
+			NumOfBeings[i] = 1;
+		}
+	}
+	ReservePicker(NumOfBeings);
+
+	const int32 PassBegin = SpawnedBeings.Num();
+	for(const FPlacementRecord& Record : Records)
+	{
+		SpawnFixedBeing(Record.ClassIndex, FVector(Record.Location), FQuat(Record.Rotation), Record.Placement, Parent);
+	}
+	MergePassIndex(PassBegin);
+}
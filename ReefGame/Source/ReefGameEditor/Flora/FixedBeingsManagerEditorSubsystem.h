@@ -0,0 +1,274 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorSubsystem.h"
+#include "ReefGameEditor/Terrain/TerrainManagerEditorSubsystem.h"
+#include "ReefGame/Flora/FixedBeing.h"
+#include "ReefGame/Flora/FixedBeingPlacement.h"
+#include "ReefGame/Flora/FixedBeingRuleTable.h"
+#include "ReefGame/Flora/FixedBeingSpatialIndex.h"
+#include "ReefGame/Flora/FixedBeingsSnapshot.h"
+#include "ReefGame/Flora/PlacementRandom.h"
+#include "ReefGame/Flora/PlacementRasters.h"
+#include "FixedBeingsManagerEditorSubsystem.generated.h"
+
+class AFixedBeing;
+class UFixedBeingInstancesComponent;
+
+USTRUCT()
+struct FFixedBeingsParameters {
+	GENERATED_BODY()
+
+	float FixedBeingPlacingPrecision = 10.f;
+	int32 FixedBeingPlacingPasses = 100;
+	float ClusterRange = 1000.f;
+	// Place the beings as instances of their class mesh, only beings that need an actor get one
+	bool bInstanced = false;
+	EFixedBeingPlacement Placement = EFixedBeingPlacement::Passes;
+
+	bool operator==(const FFixedBeingsParameters& Other) const
+	{
+		return FixedBeingPlacingPrecision == Other.FixedBeingPlacingPrecision
+		&& FixedBeingPlacingPasses == Other.FixedBeingPlacingPasses
+		&& ClusterRange == Other.ClusterRange
+		&& bInstanced == Other.bInstanced
+		&& Placement == Other.Placement;
+	}
+};
+
+/**
+ * The candidates of one placement pass in the order they are committed in, and the terrain under each of them.
+ * Samples are only filled in for the candidates that get past the rasters.
+ */
+struct FPlacementPass {
+	int32                  Pass = 0;
+	TArray<FVector2D>      Candidates;
+	TArray<FIntPoint>      Keys;     // column and row of each candidate in the pass, what its random numbers are drawn with
+	TArray<int32>          RowEnds;  // one past the last candidate of each row
+	TArray<float>          RowSteps; // Y step after each row, for the progress
+	TArray<FTerrainSample> Samples;
+};
+
+/**
+ * Cluster scores of a candidate, accumulated over the beings around it in the order they were spawned in
+ */
+struct FClusterScores {
+	float SelfPositive = 0.f;
+	float SelfNegative = 1.f;
+	float OthersPositive = 0.f;
+	float OthersNegative = 1.f;
+	int   SelfNearbyCount = 0;
+	int   OthersNearbyCount = 0;
+};
+
+/**
+ * Everything about a candidate that does not depend on what the rest of its pass places.
+ * Evaluated for the whole pass in parallel against the beings placed by the earlier passes, then committed one by one.
+ */
+struct FCandidateEvaluation {
+	int32            PickerIndex = 0;
+	float            SkewedDepthAffinity = 0.f;
+	float            SkewedFlatnessAffinity = 0.f;
+	bool             bUpsideDown = false;
+	// Turned down by its rules, its draws or the spacing to a being of an earlier pass, only the clusters of its own pass are left otherwise
+	bool             bRejected = true;
+	FClusterScores   Scores;
+};
+
+USTRUCT()
+struct FSpawnedBeing {
+	GENERATED_BODY()
+
+	FVector Location;
+
+	UPROPERTY()
+	TWeakObjectPtr<AFixedBeing> Being;
+
+	// Set instead of Being for beings placed as an instance
+	UPROPERTY()
+	TWeakObjectPtr<UFixedBeingInstancesComponent> Instances;
+	int32 InstanceIndex = INDEX_NONE;
+
+	UPROPERTY()
+	TSubclassOf<AFixedBeing> Class;
+	float MinimumSpacing = 0.f;
+
+	bool IsValid() const { return Being.IsValid() || Instances.IsValid(); }
+
+	bool operator==(const FSpawnedBeing& Other) const
+	{
+		return Being.Get() == Other.Being.Get() && Instances.Get() == Other.Instances.Get() && InstanceIndex == Other.InstanceIndex;
+	}
+};
+
+USTRUCT()
+struct FIndividualPicker {
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<AFixedBeing*> Beings;
+
+	AFixedBeing* operator[](int32 const Index) const
+	{
+		if(Index < 0 || Index >= Beings.Num())
+		{
+			return nullptr;
+		}
+		return Beings[Index];
+	}
+	int32 Num() const { return Beings.Num(); }
+	void  Add(AFixedBeing* const Being);
+	void  Empty() { Beings.Empty(); }
+	void  RemoveAt(int32 const Index);
+	// The being the next placement of this class takes, the pool is used from the back
+	AFixedBeing* Peek() const { return Beings.Num() > 0 ? Beings.Last() : nullptr; }
+	AFixedBeing* Pop() { return Beings.Num() > 0 ? Beings.Pop(false) : nullptr; }
+};
+
+
+
+/**
+ *
+ */
+UCLASS()
+class REEFGAMEEDITOR_API UFixedBeingsManagerEditorSubsystem : public UEditorSubsystem {
+	GENERATED_BODY()
+
+	UPROPERTY()
+	UTerrainManagerEditorSubsystem* TerrainManager;
+
+	UPROPERTY()
+	TArray<TSubclassOf<AFixedBeing>> FixedBeingsClasses;
+
+	UPROPERTY()
+	TArray<FSpawnedBeing> SpawnedBeings;
+
+	// The actors in SpawnedBeings, so reconciling the children of the environment is a lookup per child
+	TSet<TObjectKey<AFixedBeing>> SpawnedActors;
+	int32                         AddSpawnedBeing(FSpawnedBeing const& Spawned);
+
+	// CheckChildren requested by construction scripts, run once they stop coming
+	TWeakObjectPtr<const AActor> PendingCheckParent;
+	FTimerHandle                 CheckChildrenTimer;
+	void                         FlushCheckChildren();
+
+	UPROPERTY()
+	TArray<FIndividualPicker> Picker_Internal;
+
+	// One per class and environment, the spawned beings that were placed as instances live in these
+	UPROPERTY()
+	TArray<TWeakObjectPtr<UFixedBeingInstancesComponent>> InstanceComponents;
+	UFixedBeingInstancesComponent* GetInstances(AFixedBeing const* Template, AActor* Parent);
+	void                           RegisterInstances(UFixedBeingInstancesComponent* Component);
+
+	// SpawnedBeings by location, rebuilt before placing. Beings placed by the running pass go into PassIndex and join SpatialIndex after it
+	FFixedBeingSpatialIndex SpatialIndex;
+	FFixedBeingSpatialIndex PassIndex;
+	TArray<int32>           NearbyBeings;
+	void                    RebuildSpatialIndex();
+	void                    MergePassIndex(int32 PassBegin);
+
+	// Depth, slope and curvature of the current surface for the placement draws, rebuilt when the surface changes
+	FPlacementRasters Rasters;
+	uint32            RastersSurfaceVersion = 0;
+	// Furthest the cliffs push a vertex from its grid position, how far a candidate can land from where it was walked
+	float             MaxSurfaceDisplacement = 0.f;
+	bool              UpdateRasters();
+
+	// Rules of the front of every picker bucket, compiled at the start of each pass
+	FFixedBeingRuleTable RuleTable;
+	// The rules of the being now at the front of every bucket and whether they are still the row of RuleTable,
+	// read off the actor only when a placement takes the front
+	TArray<FFixedBeingRules> FrontRules;
+	TBitArray<>              FrontMatchesTable;
+	void                     UpdatePickerFront(int32 PickerIndex);
+
+	// Set while only a region is redistributed, in the same space as the being locations
+	TOptional<FBox2D> PlacementRegion;
+	void              DespawnRegionToPicker(FBox2D const& Region);
+	void              FilterPassToRegion(FPlacementPass& PassData) const;
+
+	// Bucket of each class met so far, subclasses of the listed classes included
+	TMap<UClass*, int32> PickerBuckets;
+
+	TArray<FIndividualPicker>& GetPicker();
+	void                          ReservePicker(TArrayView<const int32> NumOfBeings);
+	int32                         GetPickerBucket(UClass* Class);
+	bool                          CanBeInstanced(AFixedBeing const* Being) const;
+	void                          ClearPicker();
+	void                          DespawnToPicker();
+
+	void WalkPass(const int32& Pass, float Precision, int32 NumOfXVertices, int32 NumOfYVertices, FPlacementPass& OutPass) const;
+	bool PlaceFixedBeingsPass(const int32& Pass, FScopedSlowTask& Progress, AActor* Parent);
+	void WalkPoissonDisk(int32 NumOfXVertices, int32 NumOfYVertices, FPlacementPass& OutPass) const;
+	bool PlacePoissonDisk(FScopedSlowTask& Progress, AActor* Parent);
+	bool CommitPass(FPlacementPass& PassData, FScopedSlowTask& Progress, AActor* Parent);
+	void EvaluateBatch(FPlacementPass& PassData, int32 Begin, int32 End, FRuleScoringBatch& Scoring, TArray<int32>& Nearby,
+	                   TArray<FCandidateEvaluation>& Evaluations) const;
+	void EvaluateCandidate(const int32& Pass, FIntPoint Key, FVector2D const& Candidate, FTerrainSample& InOutSample, FFixedBeingRules const& Rules,
+	                       TArray<int32>& Nearby, FCandidateEvaluation& OutEvaluation) const;
+	void FinishEvaluation(FVector2D const& Candidate, FTerrainSample& InOutSample, FFixedBeingRules const& Rules, TArray<int32>& Nearby,
+	                      FCandidateEvaluation& OutEvaluation) const;
+	bool AccumulateNearby(FFixedBeingSpatialIndex const& Index, FVector const& Location, FFixedBeingRules const& Rules, TArray<int32>& Nearby,
+	                      FClusterScores& InOutScores) const;
+	void PlaceFixedBeingInEnvironment(const int32& Pass, float Y, float X, FIntPoint Key, FTerrainSample& Sample, FCandidateEvaluation& Evaluation,
+	                                  AActor* Parent);
+	void SpawnFixedBeing(int32 PickerIndex, FVector const& Location, FQuat const& Rotation, FFixedBeingPlacement const& Placement, AActor* Parent);
+
+	// Every being placed by the running redistribution, written to the placement cache once it completes
+	TArray<FPlacementRecord> PlacementRecords;
+	void                     RebuildPlacementRecords();
+	static bool              MakePlacementRecord(FSpawnedBeing const& Spawned, int32 ClassIndex, FPlacementRecord& OutRecord);
+
+	// Seconds each pass of the last redistribution took, evaluation and commit
+	TArray<double> PassTimings;
+
+	FString GetPlacementCacheKey() const;
+	FString GetPlacementCacheFilePath(FString const& Key) const;
+	bool    LoadPlacementCache(FString const& Key, TArray<FPlacementRecord>& OutRecords) const;
+	void    SavePlacementCache(FString const& Key);
+	void    ApplyPlacementRecords(TArray<FPlacementRecord> const& Records, AActor* Parent);
+
+	bool bDirty = true;
+
+	FFixedBeingsParameters Parameters;
+
+	int32 Seed = 0;
+	float GetDeterministicStep(const int32& Pass, const int32 ArraySize, float Precision, FIntPoint Key, EPlacementStream Stream) const;
+	int32 GetDeterministicPickerIndex(const int32& Pass, FIntPoint Key) const;
+	float GetDetRand0To1(const int32& Pass, FIntPoint Key, EPlacementStream Stream) const;
+
+public:
+	// Look up and store placements in Saved/PlacementCache
+	bool bUseDiskCache = true;
+	// Do not record the actors a redistribution touches for undo, the caller records a snapshot instead
+	bool bBulkEdit = true;
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	void ReleaseAll();
+	void         ClearAll();
+	void         ClearSpawned();
+	void         CheckChildren(const AActor* Parent);
+	void         RequestCheckChildren(const AActor* Parent);
+	void         SetFixedBeingsClasses(TArray<TSubclassOf<AFixedBeing>> const& NewClasses);
+	void         SetSeed(int32 NewSeed);
+
+	void RedistributeFixedBeings(FFixedBeingsParameters NewParameters, AActor* Parent, TArray<TSubclassOf<AFixedBeing>> const& NewClasses);
+	void RedistributeFixedBeingsInRegion(FBox2D const& Region, FFixedBeingsParameters NewParameters, AActor* Parent,
+	                                     TArray<TSubclassOf<AFixedBeing>> const& NewClasses);
+
+	// Write the placement rasters of the current terrain to Saved/PlacementRasters
+	bool ExportPlacementRasters();
+
+	// Beings placed by the last redistribution and how long each of its passes took, no passes run if it came from the placement cache
+	int32                 GetNumOfPlaced() const { return PlacementRecords.Num(); }
+	TArray<double> const& GetPassTimings() const { return PassTimings; }
+
+	// What is placed right now, as a compact undo entry, and putting such an entry back
+	void TakeSnapshot(UFixedBeingsSnapshot& Snapshot) const;
+	void RestorePlacement(UFixedBeingsSnapshot const& Snapshot, AActor* Parent);
+
+};
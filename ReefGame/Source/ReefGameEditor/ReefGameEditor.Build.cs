@@ -0,0 +1,17 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class ReefGameEditor : ModuleRules
+{
+	public ReefGameEditor(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "EditorSubsystem", "ReefGame" });
+
+		PrivateDependencyModuleNames.AddRange(new string[] {
+			"ProceduralMeshComponent", "UnrealEd"
+		});
+	}
+}
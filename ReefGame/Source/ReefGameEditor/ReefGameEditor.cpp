@@ -0,0 +1,27 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ReefGameEditor.h"
+#include "EnvironmentEditorActions.h"
+#include "Modules/ModuleManager.h"
+
+/**
+ * Hands the environments of the runtime module the editor actions they cannot reach on their own
+ */
+class FReefGameEditorModule : public IModuleInterface {
+	TUniquePtr<FEnvironmentEditorActions> EnvironmentEditor;
+
+public:
+	virtual void StartupModule() override
+	{
+		EnvironmentEditor = MakeUnique<FEnvironmentEditorActions>();
+		IEnvironmentEditor::Register(EnvironmentEditor.Get());
+	}
+
+	virtual void ShutdownModule() override
+	{
+		IEnvironmentEditor::Register(nullptr);
+		EnvironmentEditor.Reset();
+	}
+};
+
+IMPLEMENT_MODULE( FReefGameEditorModule, ReefGameEditor );
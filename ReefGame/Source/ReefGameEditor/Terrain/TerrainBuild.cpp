@@ -0,0 +1,841 @@
+#include "TerrainBuild.h"
+#include "ReefGameEditor/DiskCache.h"
+#include "ReefGame/Terrain/TerrainGridCell.h"
+#include "ReefGame/Terrain/TerrainQuadtreeMesh.h"
+
+#include "Curves/CurveVector.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "ProfilingDebugging/ScopedTimers.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace TerrainCache
+{
+	// Bump whenever the generation or the file layout changes so old entries are never reused
+	constexpr uint32 Version = 2;
+	constexpr uint32 Magic = 0x48435452; // "RTCH"
+	// A terrain of a million vertices takes up about 90MB
+	constexpr int64 MaxBytes = 2048ll * 1024 * 1024;
+}
+
+// Setup
+
+/**
+ * Take a copy of the cliff curve so that it can be evaluated away from the game thread
+ *
+ * @param NewCliffCurve  The curve to copy
+ */
+void FTerrainBuild::SetCliffCurve(UCurveVector const* NewCliffCurve)
+{
+	for(int32 i = 0; i < 3; i++)
+	{
+		CliffCurve[i] = NewCliffCurve->FloatCurves[i];
+	}
+}
+
+/**
+ * @return true if the build has to produce new geometry, false if it only hands the existing geometry to the mesh
+ */
+bool FTerrainBuild::HasGeometryWork() const
+{
+	return EnumHasAnyFlags(Stages, ETerrainStages::Layers | ETerrainStages::Vertices);
+}
+
+// Generation
+
+/**
+ * Run every stage of the build except the mesh hand-off, which has to happen on the game thread.
+ * Safe to call from any thread.
+ *
+ * @return false if the build was cancelled
+ */
+bool FTerrainBuild::Generate()
+{
+	return GenerateStages() && !bCancelled;
+}
+
+bool FTerrainBuild::GenerateStages()
+{
+	FString CacheKey;
+	if(HasGeometryWork())
+	{
+		// layers left behind by a cache load have to be resampled before they can be combined again
+		Stages |= StaleLayers | ETerrainStages::Vertices | ETerrainStages::Mesh | ETerrainStages::Collision;
+		StaleLayers = ETerrainStages::None;
+
+		NumOfXVertices = Parameters.GetNumOfXVertices();
+		NumOfYVertices = Parameters.GetNumOfYVertices();
+
+		// if the geometry has to be rebuilt, try the disk cache first
+		if(bUseDiskCache)
+		{
+			CacheKey = GetCacheKey();
+			bLoadedFromCache = LoadFromCache(CacheKey);
+			if(bLoadedFromCache)
+			{
+				// the loaded vertices stand in for the layers, which are resampled on the next change
+				StaleLayers = Stages & ETerrainStages::Layers;
+				Stages &= ~ETerrainStages::Layers;
+			}
+		}
+
+		FScopedDurationTimer Timer(Timings.Vertices);
+		if(!GenerateGeometry())
+		{
+			return false;
+		}
+	}
+	else if(EnumHasAnyFlags(Stages, ETerrainStages::Mesh))
+	{
+		// the vertices were expanded from the terrain manager's surface, which does not keep full precision normals
+		FScopedDurationTimer Timer(Timings.Vertices);
+		Normals.SetNumUninitialized(Vertices.Num());
+		GenerateNormalRows(0, NumOfYVertices);
+	}
+
+	if(EnumHasAnyFlags(Stages, ETerrainStages::Mesh))
+	{
+		{
+			FScopedDurationTimer Timer(Timings.Triangles);
+			if(!GenerateTriangles())
+			{
+				return false;
+			}
+		}
+		if(!bLoadedFromCache)
+		{
+			FScopedDurationTimer Timer(Timings.Tangents);
+			GenerateTangents();
+		}
+	}
+
+	if(HasGeometryWork())
+	{
+		if(bUseDiskCache && !bLoadedFromCache)
+		{
+			SaveToCache(CacheKey);
+		}
+		HeightPyramid.Build(NumOfXVertices, NumOfYVertices, [this](const int32 Index) { return Surface.GetVertex(Index); });
+	}
+
+	// the collision and the surface are taken from the full grid, only what is rendered gets simplified
+	{
+		FScopedDurationTimer Timer(Timings.Collision);
+		if(!GenerateCollision())
+		{
+			return false;
+		}
+	}
+	FScopedDurationTimer Timer(Timings.Simplify);
+	return SimplifyMesh();
+}
+
+/**
+ * Layers, vertices, normals and the compact surface, band by band of rows.
+ */
+bool FTerrainBuild::GenerateGeometry()
+{
+	const int32 NumOfVertices = NumOfXVertices * NumOfYVertices;
+	if(!bLoadedFromCache)
+	{
+		const auto PrepareLayer = [&](const ETerrainStages Layer, auto& Values)
+		{
+			if(EnumHasAnyFlags(Stages, Layer))
+			{
+				Values.SetNumUninitialized(NumOfVertices);
+			}
+		};
+		PrepareLayer(ETerrainStages::SandLayer, SandLayer);
+		PrepareLayer(ETerrainStages::CliffLayer, CliffLayer);
+		PrepareLayer(ETerrainStages::RoughnessLayer, RoughnessLayer);
+		PrepareLayer(ETerrainStages::ModifierLayer, ModifierLayer);
+
+		Vertices.SetNumUninitialized(NumOfVertices);
+		Normals.SetNumUninitialized(NumOfVertices);
+
+		// Set the min and max values to the lowest and highest possible values
+		MaxZ = TNumericLimits<float>::Lowest();
+		MinZ = TNumericLimits<float>::Max();
+		MaxX = TNumericLimits<float>::Lowest();
+		MinX = TNumericLimits<float>::Max();
+		MaxY = TNumericLimits<float>::Lowest();
+		MinY = TNumericLimits<float>::Max();
+	}
+	Surface.Init(NumOfXVertices, NumOfYVertices, Parameters.Density);
+
+	// the normals of a row need the next row, so the final rows trail the generated ones by one
+	int32 NumOfFinalRows = 0;
+	for(int32 RowBegin = 0; RowBegin < NumOfYVertices; RowBegin += RowsPerBand)
+	{
+		if(bCancelled)
+		{
+			return false;
+		}
+
+		const int32 RowEnd = FMath::Min(RowBegin + RowsPerBand, NumOfYVertices);
+		const int32 NewNumOfFinalRows = RowEnd == NumOfYVertices ? RowEnd : RowEnd - 1;
+		if(!bLoadedFromCache)
+		{
+			GenerateLayerRows(RowBegin, RowEnd);
+			GenerateVertexRows(RowBegin, RowEnd);
+			GenerateNormalRows(NumOfFinalRows, NewNumOfFinalRows);
+		}
+		Surface.CompactRows(NumOfFinalRows, NewNumOfFinalRows, Vertices, Normals);
+		NumOfFinalRows = NewNumOfFinalRows;
+	}
+	return !bCancelled;
+}
+
+/**
+ * Get the position in terrain space that the vertex at the given grid coordinates samples the noise layers at.
+ * Layers are sampled at whole units, as they always have been.
+ *
+ * @param X  The X index of the vertex in the grid.
+ * @param Y  The Y index of the vertex in the grid.
+ * @return The undisplaced position of the vertex.
+ */
+FVector2D FTerrainBuild::GetSamplePosition(const int32 X, const int32 Y) const
+{
+	return FVector2D(X / Parameters.Density, Y / Parameters.Density);
+}
+
+/**
+ * Calculate the normalized skewed distance from a specified point to the center of the terrain.
+ * The distance is adjusted based on the angle to the center and a curve defining the terrain features.
+ *
+ * @param X  The X coordinate of the specified point.
+ * @param Y  The Y coordinate of the specified point.
+ * @return The normalized skewed distance to the center.
+ */
+float FTerrainBuild::GetNormalisedSkewedDistanceToCentre(const int32 X, const int32 Y) const
+{
+	const float CentreX = Parameters.Width / 2;
+	const float CentreY = Parameters.Height / 2;
+
+	const float MaxDistToCentre = FVector2D::Distance(FVector2D(0, 0), FVector2D(CentreX, CentreY));
+
+	const float DistToCentre = FVector2D::Distance(FVector2D(X, Y), FVector2D(CentreX, CentreY));
+
+	const float DeltaX = X - CentreX;
+	const float DeltaY = Y - CentreY;
+
+	// Calculate the angle in radians between -PI and PI
+	const float Angle = FMath::Atan2(DeltaY, DeltaX);
+
+	// Normalize the angle to be between 0 and 1
+	const float NormalizedAngle = (Angle + PI) / (2 * PI); // Convert from (-PI, PI) to (0, 1)
+
+	// Get the X value of the curve at the normalized angle
+	const float XCurve = CliffCurve[0].Eval(NormalizedAngle);
+
+	// Return the normalized distance to the centre, skewed by the X value of the curve
+	return (DistToCentre / MaxDistToCentre) * XCurve;
+}
+
+
+/**
+ * Sand layer, the noise for the sand variations in elevation.
+ *
+ * @param X The X coordinate.
+ * @param Y The Y coordinate.
+ * @return The sand bank height at the specified (X, Y) coordinate.
+ */
+float FTerrainBuild::CalculateSandLayer(const int32 X, const int32 Y) const
+{
+	return FMath::PerlinNoise2D(FVector2d(X * Parameters.SandRoughness, Y * Parameters.SandRoughness)) * Parameters.SandBankHeight;
+}
+
+/**
+ * Cliff layer, everything that comes from the cliff curve.
+ *
+ * @param X The X coordinate.
+ * @param Y The Y coordinate.
+ * @return X is the normalised skewed distance to the centre, Y the encroachment and Z the height of the cliff, both before CliffIntensity.
+ */
+FVector FTerrainBuild::CalculateCliffLayer(const int32 X, const int32 Y) const
+{
+	// Get the normalised (0,1) distance to the centre of the mesh. This also includes the distortion from the X in the terrain curve
+	const float Distance = GetNormalisedSkewedDistanceToCentre(X, Y);
+
+	return FVector(Distance, CliffCurve[1].Eval(Distance), CliffCurve[2].Eval(Distance));
+}
+
+/**
+ * Roughness layer, the noise for the roughness of the cliff edge before it is scaled by the distance to the centre.
+ *
+ * @param X The X coordinate.
+ * @param Y The Y coordinate.
+ * @return The cliff edge noise at the specified (X, Y) coordinate.
+ */
+float FTerrainBuild::CalculateRoughnessLayer(const int32 X, const int32 Y) const
+{
+	return FMath::PerlinNoise2D(FVector2d(X * Parameters.CliffRoughness, Y * Parameters.CliffRoughness)) * Parameters.CliffRoughnessIntensity;
+}
+
+/**
+ * Modifier layer, the noise for the cliff modifier.
+ *
+ * @param X The X coordinate.
+ * @param Y The Y coordinate.
+ * @return The modifier height at the specified (X, Y) coordinate.
+ */
+float FTerrainBuild::CalculateModifierLayer(const int32 X, const int32 Y) const
+{
+	return FMath::PerlinNoise2D(
+		FVector2d((X + Parameters.CliffModifierSeed) * Parameters.CliffModifierDensity,
+		          (Y + Parameters.CliffModifierSeed) * Parameters.CliffModifierDensity)) * Parameters.CliffModifierIntensity;
+}
+
+/**
+ * Given a vertex, combine the cached layers into the displacement of the terrain at that position
+ * The displacement is a 3d vector where the X and Y are the XY displacement and the Z is the height
+ *
+ * @param Index The index of the vertex in the layers.
+ * @param X The X coordinate the layers were sampled at.
+ * @param Y The Y coordinate the layers were sampled at.
+ */
+FVector FTerrainBuild::CalculateDisplacement(const int32 Index, const int32 X, const int32 Y) const
+{
+	const FVector& Cliff = CliffLayer[Index];
+
+	// Noise for the roughness of the cliff edge
+	const float CliffNoise = RoughnessLayer[Index] * (Cliff.X + .3);
+
+	// How much the terrain is displaced horizontally
+	const float CliffEncroachmentAmount = Cliff.Y * Parameters.CliffIntensity;
+
+	// Direction to centre of mesh
+	const FVector DirectionOfEncroachment = FVector(Parameters.Width / 2, Parameters.Height / 2, 0) - FVector(X, Y, 0);
+
+	// The displacement is the encroachment amount plus the cliff noise in the direction of the centre
+	const FVector Encroachment = DirectionOfEncroachment.GetSafeNormal() * CliffEncroachmentAmount + CliffNoise;
+
+	// The Z value of the curve is the height of the cliff
+	const float SandbankHeight = SandLayer[Index] * (1 - Cliff.Z);
+	const float CliffHeight = Cliff.Z * Parameters.CliffIntensity;
+
+	// height is Z, encroachment is XY
+	return FVector(Encroachment.X, Encroachment.Y, SandbankHeight + CliffHeight + ModifierLayer[Index]);
+}
+
+/**
+ * Resample the noise layers flagged in Stages for a range of rows
+ */
+void FTerrainBuild::GenerateLayerRows(const int32 RowBegin, const int32 RowEnd)
+{
+	const auto GenerateLayer = [&](const ETerrainStages Layer, auto& Values, auto&& Calculate)
+	{
+		if(!EnumHasAnyFlags(Stages, Layer))
+		{
+			return;
+		}
+		for(int32 y = RowBegin; y < RowEnd; y++)
+		{
+			for(int32 x = 0; x < NumOfXVertices; x++)
+			{
+				const FVector2D Position = GetSamplePosition(x, y);
+				Values[x + y * NumOfXVertices] = Calculate(Position.X, Position.Y);
+			}
+		}
+	};
+
+	GenerateLayer(ETerrainStages::SandLayer, SandLayer, [this](const int32 X, const int32 Y) { return CalculateSandLayer(X, Y); });
+	GenerateLayer(ETerrainStages::CliffLayer, CliffLayer, [this](const int32 X, const int32 Y) { return CalculateCliffLayer(X, Y); });
+	GenerateLayer(ETerrainStages::RoughnessLayer, RoughnessLayer, [this](const int32 X, const int32 Y) { return CalculateRoughnessLayer(X, Y); });
+	GenerateLayer(ETerrainStages::ModifierLayer, ModifierLayer, [this](const int32 X, const int32 Y) { return CalculateModifierLayer(X, Y); });
+}
+
+/**
+ * Generate the vertices of a range of rows by combining the cached layers
+ */
+void FTerrainBuild::GenerateVertexRows(const int32 RowBegin, const int32 RowEnd)
+{
+	for(int32 y = RowBegin; y < RowEnd; y++)
+	{
+		for(int32 x = 0; x < NumOfXVertices; x++)
+		{
+			const FVector2d Position = GetSamplePosition(x, y);
+			FVector         Vec = FVector(Position.X, Position.Y, 0) + CalculateDisplacement(x + y * NumOfXVertices, Position.X, Position.Y);
+
+			if(Vec.Z < MinZ)
+			{
+				MinZ = Vec.Z;
+			}
+			if(Vec.Z > MaxZ)
+			{
+				MaxZ = Vec.Z;
+			}
+			if(Vec.X < MinX)
+			{
+				MinX = Vec.X;
+			}
+			if(Vec.X > MaxX)
+			{
+				MaxX = Vec.X;
+			}
+			if(Vec.Y < MinY)
+			{
+				MinY = Vec.Y;
+			}
+			if(Vec.Y > MaxY)
+			{
+				MaxY = Vec.Y;
+			}
+
+			Vertices[x + y * NumOfXVertices] = Vec;
+		}
+	}
+}
+
+/**
+ * Generate the normals of a range of rows, the normalised sum of the normals of the six grid triangles around each vertex.
+ * Only needs the rows next to the range, which is what lets the rows be finalised band by band.
+ */
+void FTerrainBuild::GenerateNormalRows(const int32 RowBegin, const int32 RowEnd)
+{
+	for(int32 y = RowBegin; y < RowEnd; y++)
+	{
+		for(int32 x = 0; x < NumOfXVertices; x++)
+		{
+			const int32 Index = x + y * NumOfXVertices;
+			FVector     Normal = FVector::ZeroVector;
+
+			// same winding as GenerateTriangles
+			const auto AddFace = [&](const int32 A, const int32 B, const int32 C)
+			{
+				Normal += FVector::CrossProduct(Vertices[C] - Vertices[A], Vertices[B] - Vertices[A]).GetSafeNormal();
+			};
+
+			const bool bLeft = x > 0;
+			const bool bRight = x < NumOfXVertices - 1;
+			const bool bDown = y > 0;
+			const bool bUp = y < NumOfYVertices - 1;
+			if(bRight && bUp)
+			{
+				AddFace(Index, Index + NumOfXVertices, Index + 1);
+			}
+			if(bLeft && bUp)
+			{
+				AddFace(Index - 1, Index - 1 + NumOfXVertices, Index);
+				AddFace(Index, Index - 1 + NumOfXVertices, Index + NumOfXVertices);
+			}
+			if(bRight && bDown)
+			{
+				AddFace(Index - NumOfXVertices, Index, Index + 1 - NumOfXVertices);
+				AddFace(Index + 1 - NumOfXVertices, Index, Index + 1);
+			}
+			if(bLeft && bDown)
+			{
+				AddFace(Index - NumOfXVertices, Index - 1, Index);
+			}
+
+			Normals[Index] = Normal.GetSafeNormal();
+		}
+	}
+}
+
+/**
+ * Generate Triangles and UVs, these only depend on the grid dimensions
+ *
+ */
+bool FTerrainBuild::GenerateTriangles()
+{
+	// Clear the triangles array
+	Triangles.Reset((NumOfXVertices - 1) * (NumOfYVertices - 1) * 6);
+	UVCoords.Reset(NumOfXVertices * NumOfYVertices);
+
+	for(int32 y = 0; y < NumOfYVertices; y++)
+	{
+		for(int32 x = 0; x < NumOfXVertices; x++)
+		{
+			UVCoords.Add(FVector2D(x, y));
+		}
+	}
+
+	for(int32 y = 0; y < NumOfYVertices - 1; y++)
+	{
+		if(bCancelled)
+		{
+			return false;
+		}
+		for(int32 x = 0; x < NumOfXVertices - 1; x++)
+		{
+			Triangles.Add(x + y * NumOfXVertices);
+			Triangles.Add(x + (y + 1) * NumOfXVertices);
+			Triangles.Add(x + 1 + y * NumOfXVertices);
+
+			Triangles.Add(x + 1 + y * NumOfXVertices);
+			Triangles.Add(x + (y + 1) * NumOfXVertices);
+			Triangles.Add(x + 1 + (y + 1) * NumOfXVertices);
+		}
+	}
+	return true;
+}
+
+
+/**
+ * Generate Tangents for the procedural mesh. The U of the UVs follows the X of the grid,
+ * so the tangent is the direction along the row made perpendicular to the normal.
+ */
+void FTerrainBuild::GenerateTangents()
+{
+	Tangents.SetNumUninitialized(Vertices.Num());
+	for(int32 y = 0; y < NumOfYVertices; y++)
+	{
+		for(int32 x = 0; x < NumOfXVertices; x++)
+		{
+			const int32   Index = x + y * NumOfXVertices;
+			const FVector Along = Vertices[FMath::Min(x + 1, NumOfXVertices - 1) + y * NumOfXVertices] - Vertices[FMath::Max(x - 1, 0) + y * NumOfXVertices];
+			const FVector Tangent = (Along - Normals[Index] * FVector::DotProduct(Along, Normals[Index])).GetSafeNormal();
+			Tangents[Index] = FProcMeshTangent(Tangent, false);
+		}
+	}
+}
+
+/**
+ * Resample the vertices on the collision grid and triangulate it the same way as the render grid.
+ * Cooking this instead of the render mesh keeps the physics cost down on dense terrains.
+ */
+bool FTerrainBuild::GenerateCollision()
+{
+	if(!EnumHasAnyFlags(Stages, ETerrainStages::Collision))
+	{
+		return !bCancelled;
+	}
+
+	const int32 NumOfXCollisionVertices = Parameters.GetNumOfXCollisionVertices();
+	const int32 NumOfYCollisionVertices = Parameters.GetNumOfYCollisionVertices();
+	const float StepX = static_cast<float>(NumOfXVertices - 1) / (NumOfXCollisionVertices - 1);
+	const float StepY = static_cast<float>(NumOfYVertices - 1) / (NumOfYCollisionVertices - 1);
+
+	CollisionVertices.Reset(NumOfXCollisionVertices * NumOfYCollisionVertices);
+	CollisionTriangles.Reset((NumOfXCollisionVertices - 1) * (NumOfYCollisionVertices - 1) * 6);
+
+	for(int32 y = 0; y < NumOfYCollisionVertices; y++)
+	{
+		if(bCancelled)
+		{
+			return false;
+		}
+		const float GridY = FMath::Min(y * StepY, static_cast<float>(NumOfYVertices - 1));
+		for(int32 x = 0; x < NumOfXCollisionVertices; x++)
+		{
+			const float      GridX = FMath::Min(x * StepX, static_cast<float>(NumOfXVertices - 1));
+			FTerrainGridCell Cell;
+			FTerrainGridCell::Find(GridX, GridY, NumOfXVertices, NumOfYVertices, Cell);
+			CollisionVertices.Add(Cell.Interpolate(Vertices));
+		}
+	}
+
+	for(int32 y = 0; y < NumOfYCollisionVertices - 1; y++)
+	{
+		for(int32 x = 0; x < NumOfXCollisionVertices - 1; x++)
+		{
+			CollisionTriangles.Add(x + y * NumOfXCollisionVertices);
+			CollisionTriangles.Add(x + (y + 1) * NumOfXCollisionVertices);
+			CollisionTriangles.Add(x + 1 + y * NumOfXCollisionVertices);
+
+			CollisionTriangles.Add(x + 1 + y * NumOfXCollisionVertices);
+			CollisionTriangles.Add(x + (y + 1) * NumOfXCollisionVertices);
+			CollisionTriangles.Add(x + 1 + (y + 1) * NumOfXCollisionVertices);
+		}
+	}
+	return !bCancelled;
+}
+
+/**
+ * Replace the full grid index buffer with an adaptive one and drop the vertices it no longer uses.
+ * Normals and tangents were calculated on the full grid and are kept as they are, so the shading still has the full detail.
+ */
+bool FTerrainBuild::SimplifyMesh()
+{
+	if(!EnumHasAnyFlags(Stages, ETerrainStages::Mesh) || Parameters.MeshTolerance <= 0)
+	{
+		return !bCancelled;
+	}
+
+	FTerrainQuadtreeMesh Quadtree(Vertices, NumOfXVertices, NumOfYVertices, Parameters.MeshTolerance);
+	if(!Quadtree.Triangulate(Triangles, [this] { return bCancelled.load(); }))
+	{
+		return false;
+	}
+
+	// New indices keep the order of the old ones, so the vertex arrays can be compacted in place
+	TArray<int32> Remap;
+	Remap.Init(INDEX_NONE, Vertices.Num());
+	for(const int32 Index : Triangles)
+	{
+		Remap[Index] = 0;
+	}
+
+	int32 NumOfUsedVertices = 0;
+	for(int32 i = 0; i < Remap.Num(); i++)
+	{
+		if(Remap[i] == INDEX_NONE)
+		{
+			continue;
+		}
+		Remap[i] = NumOfUsedVertices;
+		Vertices[NumOfUsedVertices] = Vertices[i];
+		Normals[NumOfUsedVertices] = Normals[i];
+		UVCoords[NumOfUsedVertices] = UVCoords[i];
+		Tangents[NumOfUsedVertices] = Tangents[i];
+		NumOfUsedVertices++;
+	}
+	Vertices.SetNum(NumOfUsedVertices);
+	Normals.SetNum(NumOfUsedVertices);
+	UVCoords.SetNum(NumOfUsedVertices);
+	Tangents.SetNum(NumOfUsedVertices);
+
+	for(int32& Index : Triangles)
+	{
+		Index = Remap[Index];
+	}
+	return !bCancelled;
+}
+
+// Disk Cache
+
+/**
+ * Build the cache key of the terrain being built, a hash of everything the generated geometry depends on:
+ * the parameters, every key of the cliff curve and the cache version.
+ *
+ * @return The key as a hex string
+ */
+FString FTerrainBuild::GetCacheKey() const
+{
+	FSHA1 Hash;
+	const auto Update = [&Hash](const auto& Value)
+	{
+		Hash.Update(reinterpret_cast<const uint8*>(&Value), sizeof(Value));
+	};
+
+	Update(TerrainCache::Version);
+
+	Update(Parameters.Width);
+	Update(Parameters.Height);
+	Update(Parameters.Density);
+	Update(Parameters.SandBankHeight);
+	Update(Parameters.SandRoughness);
+	Update(Parameters.PerlinOffset);
+	Update(Parameters.CliffScale);
+	Update(Parameters.CliffIntensity);
+	Update(Parameters.CliffRoughness);
+	Update(Parameters.CliffRoughnessIntensity);
+	Update(Parameters.CliffModifierSeed);
+	Update(Parameters.CliffModifierDensity);
+	Update(Parameters.CliffModifierIntensity);
+
+	for(const FRichCurve& Curve : CliffCurve)
+	{
+		Update(Curve.PreInfinityExtrap);
+		Update(Curve.PostInfinityExtrap);
+		Update(Curve.DefaultValue);
+		Update(Curve.Keys.Num());
+		for(const FRichCurveKey& Key : Curve.Keys)
+		{
+			Update(Key.InterpMode);
+			Update(Key.TangentMode);
+			Update(Key.TangentWeightMode);
+			Update(Key.Time);
+			Update(Key.Value);
+			Update(Key.ArriveTangent);
+			Update(Key.ArriveTangentWeight);
+			Update(Key.LeaveTangent);
+			Update(Key.LeaveTangentWeight);
+		}
+	}
+
+	Hash.Final();
+	FSHAHash Result;
+	Hash.GetHash(Result.Hash);
+	return Result.ToString();
+}
+
+FString FTerrainBuild::GetCacheFilePath(FString const& Key) const
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("TerrainCache"), Key + TEXT(".terrain"));
+}
+
+/**
+ * Load vertices, normals, tangents and UVs from the cache file of the given key with a single read.
+ * The build is left untouched if the file is missing or does not match.
+ *
+ * @param Key  The cache key
+ * @return true if the terrain was loaded
+ */
+bool FTerrainBuild::LoadFromCache(FString const& Key)
+{
+	TArray<uint8> Bytes;
+	if(!FFileHelper::LoadFileToArray(Bytes, *GetCacheFilePath(Key), FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Bytes);
+
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	int32  CachedNumOfXVertices = 0;
+	int32  CachedNumOfYVertices = 0;
+	Reader << Magic << Version << CachedNumOfXVertices << CachedNumOfYVertices;
+
+	const int64 NumOfVertices = static_cast<int64>(CachedNumOfXVertices) * CachedNumOfYVertices;
+	const int64 ExpectedSize = Reader.Tell()
+	+ 6 * sizeof(float) // bounds
+	+ NumOfVertices * (3 * sizeof(FVector) + sizeof(FVector2D) + sizeof(uint8)); // vertices, normals, tangents, UVs, tangent flips
+
+	if(Magic != TerrainCache::Magic || Version != TerrainCache::Version
+		|| CachedNumOfXVertices != NumOfXVertices || CachedNumOfYVertices != NumOfYVertices
+		|| Bytes.Num() != ExpectedSize)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Ignoring invalid terrain cache entry %s"), *Key);
+		return false;
+	}
+
+	Reader << MinX << MaxX << MinY << MaxY << MinZ << MaxZ;
+
+	Vertices.SetNumUninitialized(NumOfVertices);
+	Normals.SetNumUninitialized(NumOfVertices);
+	UVCoords.SetNumUninitialized(NumOfVertices);
+	TArray<FVector> TangentsX;
+	TangentsX.SetNumUninitialized(NumOfVertices);
+	TArray<uint8> TangentsFlipY;
+	TangentsFlipY.SetNumUninitialized(NumOfVertices);
+
+	Reader.Serialize(Vertices.GetData(), Vertices.NumBytes());
+	Reader.Serialize(Normals.GetData(), Normals.NumBytes());
+	Reader.Serialize(TangentsX.GetData(), TangentsX.NumBytes());
+	Reader.Serialize(UVCoords.GetData(), UVCoords.NumBytes());
+	Reader.Serialize(TangentsFlipY.GetData(), TangentsFlipY.NumBytes());
+
+	Tangents.SetNum(NumOfVertices);
+	for(int32 i = 0; i < NumOfVertices; i++)
+	{
+		Tangents[i] = FProcMeshTangent(TangentsX[i], TangentsFlipY[i] != 0);
+	}
+
+	DiskCache::Touch(GetCacheFilePath(Key));
+	UE_LOG(LogTemp, Log, TEXT("Loaded terrain from cache %s"), *Key);
+	return true;
+}
+
+/**
+ * Write the current vertices, normals, tangents and UVs to the cache file of the given key.
+ * The least recently used terrains are deleted once the cache outgrows TerrainCache::MaxBytes.
+ *
+ * @param Key  The cache key
+ */
+void FTerrainBuild::SaveToCache(FString const& Key) const
+{
+	const int32 NumOfVertices = NumOfXVertices * NumOfYVertices;
+	if(Vertices.Num() != NumOfVertices || Normals.Num() != NumOfVertices || Tangents.Num() != NumOfVertices || UVCoords.Num() != NumOfVertices)
+	{
+		return;
+	}
+
+	TArray<FVector> TangentsX;
+	TArray<uint8>   TangentsFlipY;
+	TangentsX.Reserve(NumOfVertices);
+	TangentsFlipY.Reserve(NumOfVertices);
+	for(const FProcMeshTangent& Tangent : Tangents)
+	{
+		TangentsX.Add(Tangent.TangentX);
+		TangentsFlipY.Add(Tangent.bFlipTangentY ? 1 : 0);
+	}
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+
+	uint32 Magic = TerrainCache::Magic;
+	uint32 Version = TerrainCache::Version;
+	int32  CachedNumOfXVertices = NumOfXVertices;
+	int32  CachedNumOfYVertices = NumOfYVertices;
+	float  Bounds[6] = {MinX, MaxX, MinY, MaxY, MinZ, MaxZ};
+	Writer << Magic << Version << CachedNumOfXVertices << CachedNumOfYVertices;
+	for(float& Bound : Bounds)
+	{
+		Writer << Bound;
+	}
+
+	Writer.Serialize(const_cast<FVector*>(Vertices.GetData()), Vertices.NumBytes());
+	Writer.Serialize(const_cast<FVector*>(Normals.GetData()), Normals.NumBytes());
+	Writer.Serialize(TangentsX.GetData(), TangentsX.NumBytes());
+	Writer.Serialize(const_cast<FVector2D*>(UVCoords.GetData()), UVCoords.NumBytes());
+	Writer.Serialize(TangentsFlipY.GetData(), TangentsFlipY.NumBytes());
+
+	const FString FilePath = GetCacheFilePath(Key);
+	if(!FFileHelper::SaveArrayToFile(Bytes, *FilePath))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Failed to write terrain cache %s"), *Key);
+		return;
+	}
+	DiskCache::Prune(FPaths::GetPath(FilePath), TEXT(".terrain"), TerrainCache::MaxBytes);
+}
+
+// FTerrainParameters
+
+/**
+ * Work out which generation stages are affected by going from these parameters to Other.
+ * PerlinOffset and CliffScale are not used by the generation so they never invalidate anything.
+ *
+ * @param Other  The new parameters
+ * @return The stages that have to be recomputed
+ */
+ETerrainStages FTerrainParameters::GetChangedStages(FTerrainParameters const& Other) const
+{
+	// the grid moves every sample
+	if(Width != Other.Width || Height != Other.Height || Density != Other.Density)
+	{
+		return ETerrainStages::Layers | ETerrainStages::Vertices | ETerrainStages::Collision;
+	}
+
+	ETerrainStages Stages = ETerrainStages::None;
+	if(SandBankHeight != Other.SandBankHeight || SandRoughness != Other.SandRoughness)
+	{
+		Stages |= ETerrainStages::SandLayer;
+	}
+	if(CliffRoughness != Other.CliffRoughness || CliffRoughnessIntensity != Other.CliffRoughnessIntensity)
+	{
+		Stages |= ETerrainStages::RoughnessLayer;
+	}
+	if(CliffModifierSeed != Other.CliffModifierSeed || CliffModifierDensity != Other.CliffModifierDensity || CliffModifierIntensity != Other.CliffModifierIntensity)
+	{
+		Stages |= ETerrainStages::ModifierLayer;
+	}
+	if(CollisionDensity != Other.CollisionDensity)
+	{
+		Stages |= ETerrainStages::Collision;
+	}
+	if(MeshTolerance != Other.MeshTolerance)
+	{
+		Stages |= ETerrainStages::Mesh;
+	}
+	// intensity is applied when the layers are combined
+	if(CliffIntensity != Other.CliffIntensity)
+	{
+		Stages |= ETerrainStages::Vertices;
+	}
+	return Stages;
+}
+
+bool FTerrainParameters::operator==(FTerrainParameters const& Other) const
+{
+	return Width == Other.Width
+	&& Height == Other.Height
+	&& Density == Other.Density
+	&& SandBankHeight == Other.SandBankHeight
+	&& SandRoughness == Other.SandRoughness
+	&& PerlinOffset == Other.PerlinOffset
+	&& CliffScale == Other.CliffScale
+	&& CliffIntensity == Other.CliffIntensity
+	&& CliffRoughness == Other.CliffRoughness
+	&& CliffRoughnessIntensity == Other.CliffRoughnessIntensity
+	&& CliffModifierSeed == Other.CliffModifierSeed
+	&& CliffModifierDensity == Other.CliffModifierDensity
+	&& CliffModifierIntensity == Other.CliffModifierIntensity
+	&& CollisionDensity == Other.CollisionDensity
+	&& MeshTolerance == Other.MeshTolerance;
+}
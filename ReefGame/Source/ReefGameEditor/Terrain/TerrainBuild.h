@@ -0,0 +1,176 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Curves/RichCurve.h"
+#include "ProceduralMeshComponent.h"
+#include "ReefGame/Terrain/TerrainHeightPyramid.h"
+#include "ReefGame/Terrain/TerrainSurface.h"
+#include <atomic>
+#include "TerrainBuild.generated.h"
+
+class UCurveVector;
+
+/**
+ * Stages of the terrain generation that can be recomputed independently.
+ * Each noise layer is cached per vertex so only the layers whose parameters moved are resampled,
+ * Vertices combines the cached layers and Mesh rebuilds the index buffer, UVs, tangents and normals, simplifies the result
+ * and hands everything to the procedural mesh. The terrain manager only keeps the compact surface, so the full mesh arrays are rebuilt for every hand-off.
+ * Collision resamples the vertices on the coarser collision grid, so it follows every geometry change but can also change on its own.
+ */
+enum class ETerrainStages : uint8 {
+	None           = 0,
+	SandLayer      = 1 << 0,
+	CliffLayer     = 1 << 1,
+	RoughnessLayer = 1 << 2,
+	ModifierLayer  = 1 << 3,
+	Vertices       = 1 << 4,
+	Mesh           = 1 << 5,
+	Collision      = 1 << 6,
+
+	Layers = SandLayer | CliffLayer | RoughnessLayer | ModifierLayer,
+	All    = Layers | Vertices | Mesh | Collision
+};
+
+ENUM_CLASS_FLAGS(ETerrainStages)
+
+USTRUCT()
+struct FTerrainParameters {
+	GENERATED_BODY()
+
+	int32 Width;
+	int32 Height;
+
+	float Density;
+
+	float SandBankHeight;
+	float SandRoughness;
+	float PerlinOffset;
+
+	float CliffScale;
+	float CliffIntensity;
+	float CliffRoughness;
+	float CliffRoughnessIntensity;
+
+	float CliffModifierSeed;
+	float CliffModifierDensity;
+	float CliffModifierIntensity;
+
+	// Vertices per unit of the collision grid, independent of the render Density
+	float CollisionDensity;
+
+	// How far the rendered surface may stray from the full grid, 0 renders every vertex
+	float MeshTolerance;
+
+	int32 GetNumOfXVertices() const { return FMath::CeilToInt32(Width * Density); }
+	int32 GetNumOfYVertices() const { return FMath::CeilToInt32(Height * Density); }
+	// Never finer than the render grid, never less than a single cell
+	int32 GetNumOfXCollisionVertices() const { return FMath::Clamp(FMath::CeilToInt32(Width * CollisionDensity), 2, GetNumOfXVertices()); }
+	int32 GetNumOfYCollisionVertices() const { return FMath::Clamp(FMath::CeilToInt32(Height * CollisionDensity), 2, GetNumOfYVertices()); }
+
+	// Stages that have to be recomputed to go from these parameters to Other
+	ETerrainStages GetChangedStages(FTerrainParameters const& Other) const;
+
+	// equals
+	bool operator==(FTerrainParameters const& Other) const;
+};
+
+/**
+ * Seconds spent in each stage of a build, the stages it skipped stay at zero
+ */
+struct FTerrainBuildTimings {
+	double Vertices = 0.0; // layers, vertices, normals and the compact surface
+	double Triangles = 0.0;
+	double Tangents = 0.0;
+	double Collision = 0.0;
+	double Simplify = 0.0;
+	double Mesh = 0.0; // hand-off to the procedural mesh on the game thread
+};
+
+/**
+ * A single terrain generation.
+ * Holds a snapshot of everything the generation reads (parameters, a copy of the cliff curve, the cached layers)
+ * and everything it produces, so that it can run on a worker thread without touching any UObject.
+ * The terrain manager moves the results back into itself on the game thread once it is done.
+ */
+struct FTerrainBuild {
+	FTerrainParameters Parameters;
+	// Copy of the X, Y and Z curves of the cliff UCurveVector
+	FRichCurve         CliffCurve[3];
+	ETerrainStages     Stages = ETerrainStages::None;
+	ETerrainStages     StaleLayers = ETerrainStages::None;
+	// What the terrain manager had pending when the build was prepared, only those are cleared when it is applied
+	ETerrainStages     ConsumedStages = ETerrainStages::None;
+	bool               bConsumedDirty = false;
+
+	int32 NumOfXVertices = 0;
+	int32 NumOfYVertices = 0;
+
+	TArray<float>   SandLayer;
+	TArray<FVector> CliffLayer; // X: skewed distance to centre, Y: curve encroachment, Z: curve height
+	TArray<float>   RoughnessLayer;
+	TArray<float>   ModifierLayer;
+
+	TArray<FVector>          Vertices;
+	TArray<int32>            Triangles;
+	TArray<FVector2D>        UVCoords;
+	TArray<FProcMeshTangent> Tangents;
+	TArray<FVector>          Normals;
+
+	// Built from the vertices and normals once they are final, what the terrain manager keeps
+	FTerrainSurface       Surface;
+	FTerrainHeightPyramid HeightPyramid;
+
+	// Decimated copy of the surface for the collision section, only used for the hand-off
+	TArray<FVector> CollisionVertices;
+	TArray<int32>   CollisionTriangles;
+
+	float MaxZ = TNumericLimits<float>::Lowest();
+	float MinZ = TNumericLimits<float>::Max();
+	float MaxX = TNumericLimits<float>::Lowest();
+	float MinX = TNumericLimits<float>::Max();
+	float MaxY = TNumericLimits<float>::Lowest();
+	float MinY = TNumericLimits<float>::Max();
+
+	bool bUseDiskCache = true;
+	bool bLoadedFromCache = false;
+
+	FTerrainBuildTimings Timings;
+
+	// Identifies the surface this build produces, see UTerrainManagerEditorSubsystem::GetSurfaceVersion
+	uint32 SurfaceVersion = 0;
+
+	// Rows generated at a time, the normals of a band are final once the band after it is there
+	static constexpr int32 RowsPerBand = 32;
+
+	// Set from any thread to abandon the build, checked between rows
+	std::atomic<bool> bCancelled{false};
+
+	void SetCliffCurve(UCurveVector const* NewCliffCurve);
+	bool HasGeometryWork() const;
+	bool Generate();
+
+	// Hash of everything the generated geometry depends on, also identifies the surface outside of the build
+	FString GetCacheKey() const;
+
+private:
+	FVector2D GetSamplePosition(const int32 X, const int32 Y) const;
+	float     GetNormalisedSkewedDistanceToCentre(const int32 X, const int32 Y) const;
+	float     CalculateSandLayer(const int32 X, const int32 Y) const;
+	FVector   CalculateCliffLayer(const int32 X, const int32 Y) const;
+	float     CalculateRoughnessLayer(const int32 X, const int32 Y) const;
+	float     CalculateModifierLayer(const int32 X, const int32 Y) const;
+	FVector   CalculateDisplacement(const int32 Index, const int32 X, const int32 Y) const;
+	bool      GenerateStages();
+	bool      GenerateGeometry();
+	void      GenerateLayerRows(int32 RowBegin, int32 RowEnd);
+	void      GenerateVertexRows(int32 RowBegin, int32 RowEnd);
+	void      GenerateNormalRows(int32 RowBegin, int32 RowEnd);
+	bool      GenerateTriangles();
+	void      GenerateTangents();
+	bool      GenerateCollision();
+	bool      SimplifyMesh();
+
+	FString GetCacheFilePath(FString const& Key) const;
+	bool    LoadFromCache(FString const& Key);
+	void    SaveToCache(FString const& Key) const;
+};
@@ -0,0 +1,711 @@
+
+#include "TerrainManagerEditorSubsystem.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/Async.h"
+#include "Curves/CurveVector.h"
+#include "ProceduralMeshComponent.h"
+#include "Editor.h"
+#include "Async/ParallelFor.h"
+#include "ReefGame/Terrain/TerrainHeightfield.h"
+#include "ReefGame/ScopedBulkEdit.h"
+#include "ProfilingDebugging/ScopedTimers.h"
+
+
+// Unreal Overrides
+void UTerrainManagerEditorSubsystem::Deinitialize()
+{
+	CancelTerrainGeneration();
+	Super::Deinitialize();
+}
+
+void UTerrainManagerEditorSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Subscribe to asset registry to monitor changes to the curve
+	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+	AssetRegistryModule.Get().OnAssetUpdated().AddUObject(this, &UTerrainManagerEditorSubsystem::OnCurveModified);
+
+}
+
+// Setters
+
+/**
+ *  Set the material of the procedural mesh
+ *	if the procedural mesh is not set, mark the mesh stage so that the material is set when the mesh is created
+ *
+ * @param NewMaterial  The material to set
+ */
+void UTerrainManagerEditorSubsystem::SetMaterial(UMaterialInterface* NewMaterial)
+{
+	Material = NewMaterial;
+	if(WTerrainActor.IsValid() && WTerrainActor.Get()->ProceduralMesh)
+	{
+		WTerrainActor.Get()->ProceduralMesh->SetMaterial(0, Material);
+	}
+	else
+	{
+		PendingStages |= ETerrainStages::Mesh | ETerrainStages::Collision;
+	}
+}
+
+void UTerrainManagerEditorSubsystem::CheckChildren(const AActor* Parent)
+{
+
+	TArray<AActor*> Children;
+	Parent->GetAttachedActors(Children);
+	// iterate through the actors, if they are ATerrain check if they match TerrainActor, if not, destrooy them
+	for(const auto& Child : Children)
+	{
+		if(Child->IsA(ATerrain::StaticClass()))
+		{
+			if(ATerrain* Terrain = Cast<ATerrain>(Child))
+			{
+				if(Terrain != WTerrainActor.Get())
+				{
+					Terrain->Destroy();
+				}
+			}
+		}
+	}
+}
+
+/**
+ *  Set the cliff curve and, if it changed, mark the cliff layer so that it is resampled next time the terrain is requested
+ *
+ * @param NewCliffCurve  The curve to set
+ */
+void UTerrainManagerEditorSubsystem::SetCliffCurve(UCurveVector* NewCliffCurve)
+{
+	if(CliffCurve != NewCliffCurve)
+	{
+		PendingStages |= ETerrainStages::CliffLayer;
+	}
+	CliffCurve = NewCliffCurve;
+}
+
+// Getters and Util
+
+/**
+ * Gets the position of a vertex in the procedural mesh.
+ * If the procedural mesh is not set, returns a zero vector.
+ *
+ * @param X The X coordinate of the vertex.
+ * @param Y The Y coordinate of the vertex.
+ * @return The position of the vertex as an FVector. If the procedural mesh is not set, returns FVector::ZeroVector.
+ */
+FVector UTerrainManagerEditorSubsystem::GetVertexPosition(const float X, const float Y) const
+{
+	FTerrainGridCell Cell;
+	if(!WTerrainActor.IsValid() || !WTerrainActor.Get()->ProceduralMesh || !FTerrainGridCell::Find(X, Y, NumOfXVertices, NumOfYVertices, Cell))
+	{
+		return FVector::ZeroVector;
+	}
+
+	return Cell.InterpolateBy([this](const int32 Index) { return Surface.GetVertex(Index); });
+
+}
+
+
+/**
+ * Get the normal vector at the specified vertex coordinates.
+ * If the procedural mesh is not set, a zero vector is returned.
+ *
+ * @param X The X coordinate of the vertex.
+ * @param Y The Y coordinate of the vertex.
+ * @return The normal vector at the specified vertex coordinates.
+ */
+FVector UTerrainManagerEditorSubsystem::GetNormal(const float X, const float Y) const
+{
+	FTerrainGridCell Cell;
+	if(!WTerrainActor.IsValid() || !WTerrainActor.Get()->ProceduralMesh || !FTerrainGridCell::Find(X, Y, NumOfXVertices, NumOfYVertices, Cell))
+	{
+		return FVector::ZeroVector;
+	}
+
+	return Cell.InterpolateBy([this](const int32 Index) { return Surface.GetNormal(Index); }).GetSafeNormal();
+
+}
+
+/**
+ *  Calculates the depth percentage of a vertex in the procedural mesh based on its location.
+ *  The depth percentage is the normalized distance from the maximum Z value.
+ *  1.0 is the maximum Z value, 0.0 is the minimum Z value.
+ *
+ * @param X  The X-coordinate of the vertex in the mesh.
+ * @param Y  The Y-coordinate of the vertex in the mesh.
+ * @return A float representing the depth percentage. If the coordinates are out of bounds or the mesh is not set, returns 0.f.
+ */
+float UTerrainManagerEditorSubsystem::GetDepthPercentage(const float X, const float Y) const
+{
+	FTerrainGridCell Cell;
+	if(!WTerrainActor.IsValid() || !WTerrainActor.Get()->ProceduralMesh || !FTerrainGridCell::Find(X, Y, NumOfXVertices, NumOfYVertices, Cell))
+	{
+		return 0.f;
+	}
+
+	const float HeightRange = MaxZ - MinZ;
+
+	const auto VertexHeight = Cell.InterpolateBy([this](const int32 Index) { return Surface.Heights[Index]; });
+
+	if(HeightRange > SMALL_NUMBER)
+	{
+		return 1.f - ((VertexHeight - MinZ) / HeightRange);
+	}
+
+	return 0.f;
+}
+
+/**
+ * Sample position, normal and depth percentage at once, the same values GetVertexPosition, GetNormal and GetDepthPercentage return
+ * without validating the terrain and looking up the cell three times.
+ *
+ * @param X  The X coordinate of the vertex in the mesh.
+ * @param Y  The Y coordinate of the vertex in the mesh.
+ * @return The sample, invalid and zeroed if the coordinates are out of bounds or the mesh is not set.
+ */
+FTerrainSample UTerrainManagerEditorSubsystem::SampleTerrain(const float X, const float Y) const
+{
+	FTerrainGridCell Cell;
+	if(!WTerrainActor.IsValid() || !WTerrainActor.Get()->ProceduralMesh || !FTerrainGridCell::Find(X, Y, NumOfXVertices, NumOfYVertices, Cell))
+	{
+		return FTerrainSample();
+	}
+	return Cell.SampleBy([this](const int32 Index) { return Surface.GetVertex(Index); }, [this](const int32 Index) { return Surface.GetNormal(Index); }, MinZ, MaxZ);
+}
+
+/**
+ * Sample the stored surface without checking on the terrain actor, for callers that already know the terrain is there.
+ *
+ * @param X  The X coordinate in vertices.
+ * @param Y  The Y coordinate in vertices.
+ * @return The sample, invalid if the point is outside the surface.
+ */
+FTerrainSample UTerrainManagerEditorSubsystem::SampleSurface(const float X, const float Y) const
+{
+	FTerrainGridCell Cell;
+	if(Surface.IsEmpty() || !FTerrainGridCell::Find(X, Y, NumOfXVertices, NumOfYVertices, Cell))
+	{
+		return FTerrainSample();
+	}
+	return Cell.SampleBy([this](const int32 Index) { return Surface.GetVertex(Index); }, [this](const int32 Index) { return Surface.GetNormal(Index); }, MinZ, MaxZ);
+}
+
+/**
+ * Batched SampleTerrain, the terrain is validated once and large batches are sampled in parallel.
+ *
+ * @param Points  The coordinates to sample, X and Y in vertices.
+ * @param OutSamples  One sample per point, in the same order.
+ */
+void UTerrainManagerEditorSubsystem::SampleTerrain(TArrayView<const FVector2D> Points, TArray<FTerrainSample>& OutSamples) const
+{
+	OutSamples.Reset(Points.Num());
+	OutSamples.AddDefaulted(Points.Num());
+
+	if(!WTerrainActor.IsValid() || !WTerrainActor.Get()->ProceduralMesh)
+	{
+		return;
+	}
+
+	constexpr int32 BatchSize = 1024;
+	const int32     NumOfBatches = FMath::DivideAndRoundUp(Points.Num(), BatchSize);
+	ParallelFor(NumOfBatches, [&](const int32 Batch)
+	{
+		const int32 End = FMath::Min(Points.Num(), (Batch + 1) * BatchSize);
+		for(int32 i = Batch * BatchSize; i < End; i++)
+		{
+			FTerrainGridCell Cell;
+			if(FTerrainGridCell::Find(Points[i].X, Points[i].Y, NumOfXVertices, NumOfYVertices, Cell))
+			{
+				OutSamples[i] = Cell.SampleBy([this](const int32 Index) { return Surface.GetVertex(Index); }, [this](const int32 Index) { return Surface.GetNormal(Index); }, MinZ, MaxZ);
+			}
+		}
+	});
+}
+
+/**
+ * Get the 2D bounding box of the terrain managed by the subsystem.
+ *
+ * @return The 2D bounding box represented by the minimum and maximum x and y coordinates.
+ */
+FBox2D UTerrainManagerEditorSubsystem::GetBoundingBox2D() const
+{
+	const FVector2D Min(MinX, MinY);
+	const FVector2D Max(MaxX, MaxY);
+
+	return FBox2D(Min, Max);
+}
+
+/**
+ * Retrieves the bounding box of the terrain.
+ *
+ * This function calculates the minimum and maximum points based on the internal state
+ * of the terrain manager and returns a bounding box encompassing those points.
+ *
+ * @return The bounding box defined by the minimum and maximum points.
+ */
+FBox UTerrainManagerEditorSubsystem::GetBoundingBox() const
+{
+	const FVector Min(MinX, MinY, MinZ);
+	const FVector Max(MaxX, MaxY, MaxZ);
+
+	return FBox(Min, Max);
+}
+
+/**
+ * Checks if the Terrain Manager Editor Subsystem is properly initialized.
+ *
+ * This method verifies that the essential components of the terrain manager
+ * (the surface, ProceduralMesh, Material, and CliffCurve) are properly
+ * set up and contain valid data.
+ *
+ * @return true if the subsystem is initialized and ready; false otherwise.
+ */
+bool UTerrainManagerEditorSubsystem::IsOk() const
+{
+
+	if(!WTerrainActor.IsValid() || !WTerrainActor.Get()->ProceduralMesh )
+	{
+		return false;
+	}
+
+	if(!Material)
+	{
+		return false;
+	}
+
+	if(!CliffCurve)
+	{
+		return false;
+	}
+
+	if(Surface.IsEmpty())
+	{
+		return false;
+	}
+	if(bDirty || PendingStages != ETerrainStages::None)
+	{
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Find where a segment first hits the terrain, without going through physics.
+ *
+ * @param Start  The start of the segment in terrain space
+ * @param End  The end of the segment in terrain space
+ * @param OutHit  The closest hit, only set if there is one
+ * @return true if the segment hits the terrain
+ */
+bool UTerrainManagerEditorSubsystem::RaycastTerrain(FVector const& Start, FVector const& End, FTerrainRayHit& OutHit) const
+{
+	if(!IsOk())
+	{
+		return false;
+	}
+	return HeightPyramid.Raycast(Start, End, [this](const int32 Index) { return Surface.GetVertex(Index); }, OutHit);
+}
+
+/**
+ * Check whether a sphere touches the terrain, without going through physics.
+ *
+ * @param Centre  The centre of the sphere in terrain space
+ * @param Radius  The radius of the sphere
+ * @return true if the sphere touches the terrain
+ */
+bool UTerrainManagerEditorSubsystem::SphereOverlapsTerrain(FVector const& Centre, const float Radius) const
+{
+	if(!IsOk())
+	{
+		return false;
+	}
+	return HeightPyramid.SphereOverlaps(Centre, Radius, [this](const int32 Index) { return Surface.GetVertex(Index); });
+}
+
+/**
+ * Copy the current terrain into a heightfield asset so that it can be queried at runtime by UTerrainQuerySubsystem.
+ *
+ * @param Heightfield  The asset to bake into
+ * @return false if there is no terrain to bake
+ */
+bool UTerrainManagerEditorSubsystem::BakeHeightfield(UTerrainHeightfield* Heightfield) const
+{
+	if(!Heightfield || !IsOk())
+	{
+		return false;
+	}
+
+	Heightfield->Modify();
+	Heightfield->NumOfXVertices = NumOfXVertices;
+	Heightfield->NumOfYVertices = NumOfYVertices;
+	Heightfield->Density = TerrainParameters.Density;
+	Heightfield->Bounds = GetBoundingBox();
+
+	Heightfield->Vertices.SetNumUninitialized(Surface.Num());
+	Heightfield->Normals.SetNumUninitialized(Surface.Num());
+	for(int32 i = 0; i < Surface.Num(); i++)
+	{
+		Heightfield->Vertices[i] = FVector3f(Surface.GetVertex(i));
+		Heightfield->Normals[i] = FVector3f(Surface.GetNormal(i));
+	}
+
+	Heightfield->MarkPackageDirty();
+	return true;
+}
+
+// Terrain Generation
+
+/**
+ *  Get the terrain mesh. If not generated yet null.
+ *
+ * @return The terrain mesh
+ */
+ATerrain* UTerrainManagerEditorSubsystem::GetTerrain() const
+{
+	if(!WTerrainActor.IsValid() || !WTerrainActor.Get()->ProceduralMesh || bDirty || PendingStages != ETerrainStages::None || !CliffCurve)
+	{
+		return nullptr;
+	}
+	return WTerrainActor.Get();
+}
+
+/**
+ * Retrieve or create a procedural terrain mesh using specified parameters, material, and cliff curve.
+ * A material change is applied straight to the mesh, a curve change only resamples the cliff layer.
+ *
+ * @param NewParameters The parameters defining the terrain.
+ * @param NewMaterial The material to apply to the terrain.
+ * @param NewCliffCurve The curve vector used for cliff generation.
+ * @return A pointer to the generated or updated ATerrain.
+ */
+ATerrain* UTerrainManagerEditorSubsystem::GetTerrain(FTerrainParameters const& NewParameters, UMaterialInterface* NewMaterial,
+                                                     UCurveVector*             NewCliffCurve)
+{
+	if(!NewMaterial || !NewCliffCurve)
+	{
+		return GetTerrain();
+	}
+	SetMaterial(NewMaterial);
+	SetCliffCurve(NewCliffCurve);
+	return GetTerrain(NewParameters);
+}
+
+/**
+ *  Get the terrain mesh with the given parameters, generating it on the calling thread.
+ *  Only the stages affected by the parameters that changed since the last generation (or that were invalidated since) are recomputed,
+ *  if nothing changed the cached mesh is returned.
+ *  If marked as dirty, regenerate the terrain mesh regardless of the parameters.
+ *  Any build running in the background is cancelled.
+ *
+ * @param NewParameters  The parameters to set
+ * @return The terrain mesh
+ */
+ATerrain* UTerrainManagerEditorSubsystem::GetTerrain(FTerrainParameters const& NewParameters)
+{
+	const FScopedBulkEdit BulkEdit(bBulkEdit);
+	CancelTerrainGeneration();
+
+	const auto Build = PrepareBuild(NewParameters);
+	if(!Build)
+	{
+		return nullptr;
+	}
+	if(Build->Stages == ETerrainStages::None)
+	{
+		return WTerrainActor.Get();
+	}
+
+	if(!Build->Generate() || !ApplyBuild(*Build))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to generate terrain"));
+		return nullptr;
+	}
+	return WTerrainActor.Get();
+}
+
+/**
+ *  Generate the terrain with the given parameters on a background task.
+ *  The current mesh stays in place until the new one is ready, only the hand-off to the procedural mesh happens on the game thread.
+ *  A new request cancels the one in flight, whose OnFinished is then never called.
+ *
+ * @param NewParameters The parameters defining the terrain.
+ * @param NewMaterial The material to apply to the terrain.
+ * @param NewCliffCurve The curve vector used for cliff generation.
+ * @param OnFinished Called on the game thread with the terrain, or null if the generation failed.
+ */
+void UTerrainManagerEditorSubsystem::RequestTerrain(FTerrainParameters const& NewParameters, UMaterialInterface* NewMaterial,
+                                                    UCurveVector* NewCliffCurve, TFunction<void(ATerrain*)> OnFinished)
+{
+	CancelTerrainGeneration();
+
+	if(!NewMaterial || !NewCliffCurve)
+	{
+		OnFinished(GetTerrain());
+		return;
+	}
+	SetMaterial(NewMaterial);
+	SetCliffCurve(NewCliffCurve);
+
+	const FScopedBulkEdit BulkEdit(bBulkEdit);
+	const auto            Build = PrepareBuild(NewParameters);
+	if(!Build)
+	{
+		OnFinished(nullptr);
+		return;
+	}
+	if(Build->Stages == ETerrainStages::None)
+	{
+		OnFinished(WTerrainActor.Get());
+		return;
+	}
+
+	ActiveBuild = Build;
+	Async(EAsyncExecution::ThreadPool, [WeakThis = TWeakObjectPtr<UTerrainManagerEditorSubsystem>(this), Build, OnFinished = MoveTemp(OnFinished)]() mutable
+	{
+		if(!Build->Generate())
+		{
+			return;
+		}
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Build, OnFinished = MoveTemp(OnFinished)]
+		{
+			UTerrainManagerEditorSubsystem* This = WeakThis.Get();
+			if(!This || Build->bCancelled || This->ActiveBuild != Build)
+			{
+				return;
+			}
+			This->ActiveBuild.Reset();
+			OnFinished(This->ApplyBuild(*Build) ? This->WTerrainActor.Get() : nullptr);
+		});
+	});
+}
+
+/**
+ * Cancel the build running in the background, if any. The current terrain is left untouched.
+ */
+void UTerrainManagerEditorSubsystem::CancelTerrainGeneration()
+{
+	if(ActiveBuild)
+	{
+		ActiveBuild->bCancelled = true;
+		ActiveBuild.Reset();
+	}
+}
+
+/**
+ * @return true while a build is running in the background
+ */
+bool UTerrainManagerEditorSubsystem::IsGenerating() const
+{
+	return ActiveBuild.IsValid();
+}
+
+/**
+ * Work out what has to be regenerated for the given parameters and snapshot everything the generation needs.
+ * Spawns the terrain actor if there is none.
+ *
+ * @param NewParameters  The parameters to generate
+ * @return The build, with no stages if the terrain is up to date, or null if the terrain cannot be generated
+ */
+TSharedPtr<FTerrainBuild, ESPMode::ThreadSafe> UTerrainManagerEditorSubsystem::PrepareBuild(FTerrainParameters const& NewParameters)
+{
+	if(!WTerrainActor.IsValid() || !WTerrainActor.Get()->ProceduralMesh)
+	{
+		UWorld* World = GEditor->GetEditorWorldContext().World();
+		if(!World)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to get World context"));
+			return nullptr;
+		}
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		SpawnParams.ObjectFlags = RF_Transactional;
+
+		const FTransform SpawnTransform(FRotator::ZeroRotator, FVector::ZeroVector);
+
+		WTerrainActor = World->SpawnActor<ATerrain>(ATerrain::StaticClass(), SpawnTransform, SpawnParams);
+		if(!WTerrainActor.IsValid())
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to spawn TerrainActor"));
+			return nullptr;
+		}
+
+		PendingStages |= ETerrainStages::Mesh | ETerrainStages::Collision;
+	}
+
+	const auto Build = MakeShared<FTerrainBuild, ESPMode::ThreadSafe>();
+	Build->Parameters = NewParameters;
+	Build->Stages = bDirty ? ETerrainStages::All : PendingStages | TerrainParameters.GetChangedStages(NewParameters);
+	Build->ConsumedStages = PendingStages;
+	Build->bConsumedDirty = bDirty;
+
+	if(Build->Stages == ETerrainStages::None)
+	{
+		return Build;
+	}
+
+	if(!CliffCurve)
+	{
+		UE_LOG(LogTemp, Error, TEXT("CliffCurve is not set"));
+		return nullptr;
+	}
+
+	// a layer always feeds the vertices, and anything that changes the geometry needs new tangents, normals and mesh
+	if(EnumHasAnyFlags(Build->Stages, ETerrainStages::Layers))
+	{
+		Build->Stages |= ETerrainStages::Vertices;
+	}
+	if(EnumHasAnyFlags(Build->Stages, ETerrainStages::Vertices))
+	{
+		Build->Stages |= ETerrainStages::Mesh | ETerrainStages::Collision;
+	}
+
+	Build->SetCliffCurve(CliffCurve);
+	Build->bUseDiskCache = bUseDiskCache;
+
+	// the build works on copies so the current terrain stays usable until it is replaced
+	if(Build->HasGeometryWork())
+	{
+		Build->SurfaceVersion = ++LatestSurfaceVersion;
+		Build->StaleLayers = StaleLayers;
+		Build->SandLayer = SandLayer;
+		Build->CliffLayer = CliffLayer;
+		Build->RoughnessLayer = RoughnessLayer;
+		Build->ModifierLayer = ModifierLayer;
+	}
+	else if(EnumHasAnyFlags(Build->Stages, ETerrainStages::Mesh | ETerrainStages::Collision))
+	{
+		// the geometry did not change, the mesh and the collision are rebuilt from the current surface
+		Build->NumOfXVertices = NumOfXVertices;
+		Build->NumOfYVertices = NumOfYVertices;
+		Surface.ExpandVertices(Build->Vertices);
+	}
+	return Build;
+}
+
+/**
+ * Move the results of a finished build into the subsystem and hand them to the procedural mesh.
+ * Game thread only.
+ *
+ * @param Build  The finished build
+ * @return false if the terrain actor went away in the meantime
+ */
+bool UTerrainManagerEditorSubsystem::ApplyBuild(FTerrainBuild& Build)
+{
+	check(IsInGameThread());
+
+	// the mesh sections are far too large to keep in the undo buffer
+	const FScopedBulkEdit BulkEdit(bBulkEdit);
+
+	if(!WTerrainActor.IsValid() || !WTerrainActor.Get()->ProceduralMesh)
+	{
+		PendingStages |= Build.Stages;
+		return false;
+	}
+
+	if(Build.HasGeometryWork())
+	{
+		StaleLayers = Build.StaleLayers;
+		SandLayer = MoveTemp(Build.SandLayer);
+		CliffLayer = MoveTemp(Build.CliffLayer);
+		RoughnessLayer = MoveTemp(Build.RoughnessLayer);
+		ModifierLayer = MoveTemp(Build.ModifierLayer);
+		Surface = MoveTemp(Build.Surface);
+		SurfaceVersion = Build.SurfaceVersion;
+		SurfaceKey = Build.GetCacheKey();
+		HeightPyramid = MoveTemp(Build.HeightPyramid);
+
+		NumOfXVertices = Build.NumOfXVertices;
+		NumOfYVertices = Build.NumOfYVertices;
+		MaxZ = Build.MaxZ;
+		MinZ = Build.MinZ;
+		MaxX = Build.MaxX;
+		MinX = Build.MinX;
+		MaxY = Build.MaxY;
+		MinY = Build.MinY;
+	}
+
+	TerrainParameters = Build.Parameters;
+
+	if(EnumHasAnyFlags(Build.Stages, ETerrainStages::Mesh))
+	{
+		FScopedDurationTimer Timer(Build.Timings.Mesh);
+
+		// the render section never collides, collision comes from the decimated section below
+		UProceduralMeshComponent* ProceduralMesh = WTerrainActor.Get()->ProceduralMesh;
+		ProceduralMesh->CreateMeshSection(
+			0,
+			Build.Vertices,
+			Build.Triangles,
+			Build.Normals,
+			Build.UVCoords,
+			TArray<FColor>(),
+			Build.Tangents,
+			false
+		);
+		ProceduralMesh->SetMaterial(0, Material);
+	}
+
+	if(EnumHasAnyFlags(Build.Stages, ETerrainStages::Collision))
+	{
+		// hidden section that is only there to be cooked, asynchronously since the terrain enables async cooking
+		UProceduralMeshComponent* ProceduralMesh = WTerrainActor.Get()->ProceduralMesh;
+		ProceduralMesh->CreateMeshSection(
+			ATerrain::CollisionSectionIndex,
+			Build.CollisionVertices,
+			Build.CollisionTriangles,
+			TArray<FVector>(),
+			TArray<FVector2D>(),
+			TArray<FColor>(),
+			TArray<FProcMeshTangent>(),
+			true
+		);
+		ProceduralMesh->SetMeshSectionVisible(ATerrain::CollisionSectionIndex, false);
+	}
+
+	LastBuildTimings = Build.Timings;
+
+	// a curve or material change that came in while the build was running is still pending
+	PendingStages &= ~Build.ConsumedStages;
+	if(Build.bConsumedDirty)
+	{
+		bDirty = false;
+	}
+	return true;
+}
+
+// Curve
+
+/**
+ *  Called when any asset is modified, checks if the asset is the curve we have and sets the dirty flag
+ *
+ * @param AssetData  The asset data of the modified asset
+ */
+void UTerrainManagerEditorSubsystem::OnCurveModified(const FAssetData& AssetData)
+{
+	if(!AssetData.IsValid())
+	{
+		return;
+	}
+
+	const auto Asset = AssetData.GetAsset();
+	if(!Asset)
+	{
+		return;
+	}
+
+	if(!CliffCurve)
+	{
+		return;
+	}
+
+	// if the asset is the curve we have
+	if(Asset->GetFName() == CliffCurve->GetFName())
+	{
+		// only the cliff layer samples the curve
+		PendingStages |= ETerrainStages::CliffLayer;
+	}
+}
+
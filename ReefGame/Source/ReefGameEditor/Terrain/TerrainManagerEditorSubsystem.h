@@ -0,0 +1,119 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorSubsystem.h"
+#include "ReefGame/Terrain/Terrain.h"
+#include "TerrainBuild.h"
+#include "ReefGame/Terrain/TerrainGridCell.h"
+#include "TerrainManagerEditorSubsystem.generated.h"
+
+class UProceduralMeshComponent;
+class UCurveVector;
+class UTerrainHeightfield;
+
+UCLASS()
+class REEFGAMEEDITOR_API UTerrainManagerEditorSubsystem : public UEditorSubsystem {
+	GENERATED_BODY()
+
+
+	UPROPERTY()
+	UCurveVector* CliffCurve;
+
+	UPROPERTY()
+	TWeakObjectPtr<ATerrain> WTerrainActor;
+
+	// Compact copy of the generated vertices and normals, the procedural mesh holds the full mesh
+	FTerrainSurface Surface;
+
+	UPROPERTY()
+	UMaterialInterface* Material;
+
+	UPROPERTY()
+	FTerrainParameters TerrainParameters;
+
+	// Per vertex noise layers, kept so that a change to one layer does not resample the others
+	TArray<float>   SandLayer;
+	TArray<FVector> CliffLayer; // X: skewed distance to centre, Y: curve encroachment, Z: curve height
+	TArray<float>   RoughnessLayer;
+	TArray<float>   ModifierLayer;
+
+	// Bounds hierarchy over the surface for ray and sphere queries
+	FTerrainHeightPyramid HeightPyramid;
+
+	// Stages invalidated outside of a parameter change (curve edits, missing mesh...)
+	ETerrainStages PendingStages = ETerrainStages::All;
+
+	// Layers that no longer match the vertices because the vertices were loaded from the disk cache
+	ETerrainStages StaleLayers = ETerrainStages::None;
+
+	// Version of the current surface and the last one handed to a build
+	uint32 SurfaceVersion = 0;
+	uint32 LatestSurfaceVersion = 0;
+	// Cache key of the build the current surface came from, stays the same across sessions
+	FString SurfaceKey;
+
+	// Build running in the background, if any
+	TSharedPtr<FTerrainBuild, ESPMode::ThreadSafe> ActiveBuild;
+
+	FTerrainBuildTimings LastBuildTimings;
+
+	TSharedPtr<FTerrainBuild, ESPMode::ThreadSafe> PrepareBuild(FTerrainParameters const& NewParameters);
+	bool                                           ApplyBuild(FTerrainBuild& Build);
+
+public:
+	bool bDirty = true;
+	// Look up and store generated terrains in Saved/TerrainCache
+	bool bUseDiskCache = true;
+	// Do not record the terrain actor and its mesh for undo when generating, the terrain follows the environment parameters anyway
+	bool bBulkEdit = true;
+	int32 NumOfXVertices;
+	int32 NumOfYVertices;
+	float MaxZ = TNumericLimits<float>::Lowest();
+	float MinZ = TNumericLimits<float>::Max();
+	float MaxX = TNumericLimits<float>::Lowest();
+	float MinX = TNumericLimits<float>::Max();
+	float MaxY = TNumericLimits<float>::Lowest();
+	float MinY = TNumericLimits<float>::Max();
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	void         OnCurveModified(const FAssetData& AssetData);
+	virtual void Deinitialize() override;
+
+	void Release();
+
+	void SetMaterial(UMaterialInterface* NewMaterial);
+
+	void      CheckChildren(const AActor* Parent);
+	void      SetCliffCurve(UCurveVector* NewCliffCurve);
+	FVector   GetVertexPosition(float X, float Y) const;
+	FVector   GetNormal(float X, float Y) const;
+	float     GetDepthPercentage(float X, float Y) const;
+	FTerrainSample SampleTerrain(float X, float Y) const;
+	void      SampleTerrain(TArrayView<const FVector2D> Points, TArray<FTerrainSample>& OutSamples) const;
+	// SampleTerrain straight from the surface, safe on any thread while no build is being applied
+	FTerrainSample SampleSurface(float X, float Y) const;
+	FTerrainSurface const& GetSurface() const { return Surface; }
+	FBox2D    GetBoundingBox2D() const;
+	FBox      GetBoundingBox() const;
+	bool      IsOk() const;
+	bool      RaycastTerrain(FVector const& Start, FVector const& End, FTerrainRayHit& OutHit) const;
+	bool      SphereOverlapsTerrain(FVector const& Centre, float Radius) const;
+	bool      BakeHeightfield(UTerrainHeightfield* Heightfield) const;
+	ATerrain* GetTerrain() const;
+	ATerrain* GetTerrain(FTerrainParameters const& NewParameters, UMaterialInterface* NewMaterial, UCurveVector* NewCliffCurve);
+
+	ATerrain* GetTerrain(FTerrainParameters const& NewParameters);
+
+	void RequestTerrain(FTerrainParameters const& NewParameters, UMaterialInterface* NewMaterial, UCurveVector* NewCliffCurve,
+	                    TFunction<void(ATerrain*)> OnFinished);
+	void CancelTerrainGeneration();
+	bool IsGenerating() const;
+	// Changes every time the generated geometry does
+	uint32 GetSurfaceVersion() const { return SurfaceVersion; }
+	// Identifies the current surface across sessions, empty until a terrain has been generated
+	FString const& GetSurfaceKey() const { return SurfaceKey; }
+	// Vertices per unit of the current terrain
+	float GetDensity() const { return TerrainParameters.Density; }
+	// Stage timings of the last build that was applied
+	FTerrainBuildTimings const& GetLastBuildTimings() const { return LastBuildTimings; }
+};